@@ -0,0 +1,329 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "colorutl.h"
+#include <statUtils/statutl.h>
+#include "cpulevel.h"
+
+// Samples are mapped to palette indices in chunks; the chunk lives on the stack.
+#define COLORMAP_CHUNK 64
+
+// Viridis-like control points (r, g, b), evenly spaced over 0..1.
+static const uint8_t VIRIDIS_STOPS[9][3] = {
+    { 68,   1,  84 },
+    { 71,  44, 122 },
+    { 59,  81, 139 },
+    { 44, 113, 142 },
+    { 33, 144, 141 },
+    { 39, 173, 129 },
+    { 92, 200,  99 },
+    {170, 220,  50 },
+    {253, 231,  37 }
+};
+
+static void colormap_entry(colormap_kind_t kind, float t, uint8_t *r, uint8_t *g, uint8_t *b) {
+    switch (kind) {
+    case COLORMAP_HUE: {
+        // Blue (cold) -> red (hot), like a classic spectrum waterfall.
+        float rf, gf, bf;
+        hsv2rgb(240.0f * (1.0f - t), 1.0f, 1.0f, &rf, &gf, &bf);
+        f01_2rgb888(rf, gf, bf, r, g, b);
+        break;
+    }
+    case COLORMAP_VIRIDIS: {
+        float pos = t * 8.0f;
+        int k = (int)pos;
+        if (k > 7) k = 7;
+        float f = pos - k;
+        *r = (uint8_t)(VIRIDIS_STOPS[k][0] + (VIRIDIS_STOPS[k + 1][0] - VIRIDIS_STOPS[k][0]) * f + 0.5f);
+        *g = (uint8_t)(VIRIDIS_STOPS[k][1] + (VIRIDIS_STOPS[k + 1][1] - VIRIDIS_STOPS[k][1]) * f + 0.5f);
+        *b = (uint8_t)(VIRIDIS_STOPS[k][2] + (VIRIDIS_STOPS[k + 1][2] - VIRIDIS_STOPS[k][2]) * f + 0.5f);
+        break;
+    }
+    case COLORMAP_GRAY:
+    default:
+        *r = *g = *b = (uint8_t)(t * 255.0f + 0.5f);
+        break;
+    }
+}
+
+static void __c_O_l_O_r_M_a_P_s_E_t_R_a_N_g_E__(colormap_t *cm, float min, float max) {
+    if (!cm) return;
+    cm->min = min;
+    cm->max = max;
+    cm->scale = (max > min) ? (float)(cm->size - 1) / (max - min) : 0.0f;
+}
+
+static int __c_O_l_O_r_M_a_P_i_N_i_T__(colormap_t *cm, colormap_kind_t kind, uint16_t size, float min, float max) {
+    if (!cm) return -1;
+    if (size != 256 && size != 1024) return -1;
+
+    cm->size = size;
+    for (uint16_t i = 0; i < size; i++) {
+        uint8_t r, g, b;
+        colormap_entry(kind, (float)i / (size - 1), &r, &g, &b);
+        cm->rgb565[i] = rgb888_2rgb565(r, g, b);
+        cm->rgb888[i][0] = r;
+        cm->rgb888[i][1] = g;
+        cm->rgb888[i][2] = b;
+        cm->ansi256[i] = rgb2ansi256(r, g, b);
+    }
+    __c_O_l_O_r_M_a_P_s_E_t_R_a_N_g_E__(cm, min, max);
+    return 0;
+}
+
+// Sample -> palette index: clamp((x - min) * scale + 0.5, 0, size - 1), NaN maps to 0.
+static inline uint16_t colormap_index_1(const colormap_t *cm, float x) {
+    float t = (x - cm->min) * cm->scale + 0.5f;
+    float last = (float)(cm->size - 1);
+    if (!(t > 0)) t = 0;
+    if (t > last) t = last;
+    return (uint16_t)t;
+}
+
+// Vector bodies index as many samples as fit their width and report how many via *done;
+// the scalar loop finishes the rest. The level is picked once from cpuLevel().
+typedef void (*colormap_index_f32_fn)(const colormap_t *cm, const float *src, uint16_t *idx, size_t n, size_t *done);
+typedef void (*colormap_index_i16_fn)(const colormap_t *cm, const int16_t *src, uint16_t *idx, size_t n, size_t *done);
+typedef void (*colormap_index_i8_fn)(const colormap_t *cm, const int8_t *src, uint16_t *idx, size_t n, size_t *done);
+
+typedef struct {
+    colormap_index_f32_fn f32;
+    colormap_index_i16_fn i16;
+    colormap_index_i8_fn i8;
+} colormap_impl_t;
+
+#if defined(__SSE2__)
+static inline __m128i colormap_index_sse2(__m128 x, __m128 min, __m128 scale, __m128 last) {
+    __m128 t = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, min), scale), _mm_set1_ps(0.5f));
+    t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), last); // max_ps returns 0 for NaN
+    return _mm_cvttps_epi32(t);
+}
+
+static void colormap_index_f32_sse2(const colormap_t *cm, const float *src, uint16_t *idx, size_t n, size_t *done) {
+    size_t i = 0;
+    __m128 min = _mm_set1_ps(cm->min);
+    __m128 scale = _mm_set1_ps(cm->scale);
+    __m128 last = _mm_set1_ps((float)(cm->size - 1));
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = colormap_index_sse2(_mm_loadu_ps(src + i), min, scale, last);
+        __m128i hi = colormap_index_sse2(_mm_loadu_ps(src + i + 4), min, scale, last);
+        _mm_storeu_si128((__m128i *)(idx + i), _mm_packs_epi32(lo, hi));
+    }
+    *done = i;
+}
+
+static void colormap_index_i16_sse2(const colormap_t *cm, const int16_t *src, uint16_t *idx, size_t n, size_t *done) {
+    size_t i = 0;
+    __m128 min = _mm_set1_ps(cm->min);
+    __m128 scale = _mm_set1_ps(cm->scale);
+    __m128 last = _mm_set1_ps((float)(cm->size - 1));
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        lo = colormap_index_sse2(_mm_cvtepi32_ps(lo), min, scale, last);
+        hi = colormap_index_sse2(_mm_cvtepi32_ps(hi), min, scale, last);
+        _mm_storeu_si128((__m128i *)(idx + i), _mm_packs_epi32(lo, hi));
+    }
+    *done = i;
+}
+
+static void colormap_index_i8_sse2(const colormap_t *cm, const int8_t *src, uint16_t *idx, size_t n, size_t *done) {
+    size_t i = 0;
+    __m128 min = _mm_set1_ps(cm->min);
+    __m128 scale = _mm_set1_ps(cm->scale);
+    __m128 last = _mm_set1_ps((float)(cm->size - 1));
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i w[2] = { _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8),
+                         _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8) };
+        for (int k = 0; k < 2; k++) {
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(w[k], w[k]), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(w[k], w[k]), 16);
+            lo = colormap_index_sse2(_mm_cvtepi32_ps(lo), min, scale, last);
+            hi = colormap_index_sse2(_mm_cvtepi32_ps(hi), min, scale, last);
+            _mm_storeu_si128((__m128i *)(idx + i + 8 * k), _mm_packs_epi32(lo, hi));
+        }
+    }
+    *done = i;
+}
+
+static const colormap_impl_t COLORMAP_SSE2 = { colormap_index_f32_sse2, colormap_index_i16_sse2, colormap_index_i8_sse2 };
+#endif // __SSE2__
+
+#if COLORUTL_X86_DISPATCH
+
+AVX2_FN __m256i colormap_index_avx2(__m256 x, __m256 min, __m256 scale, __m256 last) {
+    __m256 t = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(x, min), scale), _mm256_set1_ps(0.5f));
+    t = _mm256_min_ps(_mm256_max_ps(t, _mm256_setzero_ps()), last);
+    return _mm256_cvttps_epi32(t);
+}
+
+// packs_epi32 interleaves the 128-bit lanes; permute restores sample order.
+AVX2_FN void colormap_store16_avx2(uint16_t *idx, __m256i lo, __m256i hi) {
+    _mm256_storeu_si256((__m256i *)idx, _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+}
+
+__attribute__((target("avx2")))
+static void colormap_index_f32_avx2(const colormap_t *cm, const float *src, uint16_t *idx, size_t n, size_t *done) {
+    size_t i = 0;
+    __m256 min = _mm256_set1_ps(cm->min);
+    __m256 scale = _mm256_set1_ps(cm->scale);
+    __m256 last = _mm256_set1_ps((float)(cm->size - 1));
+    for (; i + 16 <= n; i += 16) {
+        __m256i lo = colormap_index_avx2(_mm256_loadu_ps(src + i), min, scale, last);
+        __m256i hi = colormap_index_avx2(_mm256_loadu_ps(src + i + 8), min, scale, last);
+        colormap_store16_avx2(idx + i, lo, hi);
+    }
+    *done = i;
+}
+
+__attribute__((target("avx2")))
+static void colormap_index_i16_avx2(const colormap_t *cm, const int16_t *src, uint16_t *idx, size_t n, size_t *done) {
+    size_t i = 0;
+    __m256 min = _mm256_set1_ps(cm->min);
+    __m256 scale = _mm256_set1_ps(cm->scale);
+    __m256 last = _mm256_set1_ps((float)(cm->size - 1));
+    for (; i + 16 <= n; i += 16) {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(src + i + 8)));
+        lo = colormap_index_avx2(_mm256_cvtepi32_ps(lo), min, scale, last);
+        hi = colormap_index_avx2(_mm256_cvtepi32_ps(hi), min, scale, last);
+        colormap_store16_avx2(idx + i, lo, hi);
+    }
+    *done = i;
+}
+
+__attribute__((target("avx2")))
+static void colormap_index_i8_avx2(const colormap_t *cm, const int8_t *src, uint16_t *idx, size_t n, size_t *done) {
+    size_t i = 0;
+    __m256 min = _mm256_set1_ps(cm->min);
+    __m256 scale = _mm256_set1_ps(cm->scale);
+    __m256 last = _mm256_set1_ps((float)(cm->size - 1));
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m256i lo = _mm256_cvtepi8_epi32(v);
+        __m256i hi = _mm256_cvtepi8_epi32(_mm_srli_si128(v, 8));
+        lo = colormap_index_avx2(_mm256_cvtepi32_ps(lo), min, scale, last);
+        hi = colormap_index_avx2(_mm256_cvtepi32_ps(hi), min, scale, last);
+        colormap_store16_avx2(idx + i, lo, hi);
+    }
+    *done = i;
+}
+
+static const colormap_impl_t COLORMAP_AVX2 = { colormap_index_f32_avx2, colormap_index_i16_avx2, colormap_index_i8_avx2 };
+#endif // COLORUTL_X86_DISPATCH
+
+static const colormap_impl_t COLORMAP_SCALAR = { NULL, NULL, NULL };
+
+static const colormap_impl_t *colormap_impl(void) {
+    return CPU_LEVEL_DISPATCH(const colormap_impl_t *, &COLORMAP_SCALAR, &COLORMAP_SSE2, &COLORMAP_AVX2);
+}
+
+static void colormap_index_f32(const colormap_t *cm, const float *src, uint16_t *idx, size_t n) {
+    const colormap_impl_t *impl = colormap_impl();
+    size_t i = 0;
+    if (impl->f32) impl->f32(cm, src, idx, n, &i);
+    for (; i < n; i++) idx[i] = colormap_index_1(cm, src[i]);
+}
+
+static void colormap_index_i16(const colormap_t *cm, const int16_t *src, uint16_t *idx, size_t n) {
+    const colormap_impl_t *impl = colormap_impl();
+    size_t i = 0;
+    if (impl->i16) impl->i16(cm, src, idx, n, &i);
+    for (; i < n; i++) idx[i] = colormap_index_1(cm, (float)src[i]);
+}
+
+static void colormap_index_i8(const colormap_t *cm, const int8_t *src, uint16_t *idx, size_t n) {
+    const colormap_impl_t *impl = colormap_impl();
+    size_t i = 0;
+    if (impl->i8) impl->i8(cm, src, idx, n, &i);
+    for (; i < n; i++) idx[i] = colormap_index_1(cm, (float)src[i]);
+}
+
+static void colormap_gather(const colormap_t *cm, const uint16_t *idx, size_t n, colormap_out_t out, void *dst) {
+    switch (out) {
+    case COLORMAP_RGB565: {
+        uint16_t *d = (uint16_t *)dst;
+        for (size_t i = 0; i < n; i++) d[i] = cm->rgb565[idx[i]];
+        break;
+    }
+    case COLORMAP_RGB888: {
+        uint8_t *d = (uint8_t *)dst;
+        for (size_t i = 0; i < n; i++, d += 3) {
+            d[0] = cm->rgb888[idx[i]][0];
+            d[1] = cm->rgb888[idx[i]][1];
+            d[2] = cm->rgb888[idx[i]][2];
+        }
+        break;
+    }
+    case COLORMAP_ANSI256: {
+        uint8_t *d = (uint8_t *)dst;
+        for (size_t i = 0; i < n; i++) d[i] = cm->ansi256[idx[i]];
+        break;
+    }
+    }
+}
+
+static size_t colormap_out_bpp(colormap_out_t out) {
+    return (out == COLORMAP_RGB565) ? 2 : ((out == COLORMAP_RGB888) ? 3 : 1);
+}
+
+static void __c_O_l_O_r_M_a_P_r_O_w_F_3_2__(const colormap_t *cm, const float *src, size_t n,
+                                            colormap_out_t out, void *dst) {
+    if (!cm || !src || !dst) return;
+    STAT_SCOPE_BEGIN(scope);
+    uint16_t idx[COLORMAP_CHUNK];
+    uint8_t *d = (uint8_t *)dst;
+    size_t bpp = colormap_out_bpp(out);
+    for (size_t i = 0; i < n; i += COLORMAP_CHUNK) {
+        size_t len = (n - i < COLORMAP_CHUNK) ? n - i : COLORMAP_CHUNK;
+        colormap_index_f32(cm, src + i, idx, len);
+        colormap_gather(cm, idx, len, out, d + i * bpp);
+    }
+    STAT_SCOPE_END(scope, STAT_COLORMAP_ROW, n * bpp);
+}
+
+static void __c_O_l_O_r_M_a_P_r_O_w_I_1_6__(const colormap_t *cm, const int16_t *src, size_t n,
+                                            colormap_out_t out, void *dst) {
+    if (!cm || !src || !dst) return;
+    STAT_SCOPE_BEGIN(scope);
+    uint16_t idx[COLORMAP_CHUNK];
+    uint8_t *d = (uint8_t *)dst;
+    size_t bpp = colormap_out_bpp(out);
+    for (size_t i = 0; i < n; i += COLORMAP_CHUNK) {
+        size_t len = (n - i < COLORMAP_CHUNK) ? n - i : COLORMAP_CHUNK;
+        colormap_index_i16(cm, src + i, idx, len);
+        colormap_gather(cm, idx, len, out, d + i * bpp);
+    }
+    STAT_SCOPE_END(scope, STAT_COLORMAP_ROW, n * bpp);
+}
+
+static void __c_O_l_O_r_M_a_P_r_O_w_I_8__(const colormap_t *cm, const int8_t *src, size_t n,
+                                         colormap_out_t out, void *dst) {
+    if (!cm || !src || !dst) return;
+    STAT_SCOPE_BEGIN(scope);
+    uint16_t idx[COLORMAP_CHUNK];
+    uint8_t *d = (uint8_t *)dst;
+    size_t bpp = colormap_out_bpp(out);
+    for (size_t i = 0; i < n; i += COLORMAP_CHUNK) {
+        size_t len = (n - i < COLORMAP_CHUNK) ? n - i : COLORMAP_CHUNK;
+        colormap_index_i8(cm, src + i, idx, len);
+        colormap_gather(cm, idx, len, out, d + i * bpp);
+    }
+    STAT_SCOPE_END(scope, STAT_COLORMAP_ROW, n * bpp);
+}
+
+
+__attribute__((weak, alias("__c_O_l_O_r_M_a_P_i_N_i_T__")))
+int colormapInit(colormap_t *cm, colormap_kind_t kind, uint16_t size, float min, float max);
+__attribute__((weak, alias("__c_O_l_O_r_M_a_P_s_E_t_R_a_N_g_E__")))
+void colormapSetRange(colormap_t *cm, float min, float max);
+__attribute__((weak, alias("__c_O_l_O_r_M_a_P_r_O_w_F_3_2__")))
+void colormapRowF32(const colormap_t *cm, const float *src, size_t n, colormap_out_t out, void *dst);
+__attribute__((weak, alias("__c_O_l_O_r_M_a_P_r_O_w_I_1_6__")))
+void colormapRowI16(const colormap_t *cm, const int16_t *src, size_t n, colormap_out_t out, void *dst);
+__attribute__((weak, alias("__c_O_l_O_r_M_a_P_r_O_w_I_8__")))
+void colormapRowI8(const colormap_t *cm, const int8_t *src, size_t n, colormap_out_t out, void *dst);
@@ -2,6 +2,7 @@
 #define COLORUTL_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #define CLAMP01(x) ((float)(x) < 0 ? 0 : ((float)(x) > 1 ? 1 : (float)(x)))
 
@@ -23,11 +24,114 @@ typedef uint32_t RGBA32_t;  // 0xRRGGBBAA
 
 #define RGBA32_GET(r, g, b, a) (((r) << 24) | ((g) << 16) | ((b) << 8) | (a))
 
+// Builds where AVX2 kernels are compiled in (via target attributes) and picked at run time.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COLORUTL_X86_DISPATCH 1
+#else
+#define COLORUTL_X86_DISPATCH 0
+#endif
+
+typedef enum {
+    CPU_LEVEL_SCALAR = 0,
+    CPU_LEVEL_SSE2,
+    CPU_LEVEL_AVX2
+} cpu_level_t;
+
+#define COLORMAP_MAX_SIZE 1024
+
+typedef enum {
+    COLORMAP_HUE = 0,   // blue -> red hue ramp
+    COLORMAP_VIRIDIS,   // viridis-like perceptual ramp
+    COLORMAP_GRAY
+} colormap_kind_t;
+
+typedef enum {
+    COLORMAP_RGB565 = 0, // uint16_t per pixel
+    COLORMAP_RGB888,     // 3 bytes per pixel (r, g, b)
+    COLORMAP_ANSI256     // uint8_t ANSI 256 color index per pixel
+} colormap_out_t;
+
+// Precomputed palette; samples in [min, max] map linearly onto entries 0..size-1.
+typedef struct {
+    uint16_t size;      // 256 or 1024
+    float min, max;
+    float scale;        // (size - 1) / (max - min)
+    uint16_t rgb565[COLORMAP_MAX_SIZE];
+    uint8_t rgb888[COLORMAP_MAX_SIZE][3];
+    uint8_t ansi256[COLORMAP_MAX_SIZE];
+} colormap_t;
+
+#define PALETTE_MAX_SIZE 256
+
+// Custom palette (e-paper, 16-colour terminals, indexed LCDs) with a lookup
+// structure for nearest-colour search. Set up with paletteInit(), release
+// with paletteFree().
+typedef struct {
+    uint16_t size;
+    uint8_t rgb888[PALETTE_MAX_SIZE][3];
+    uint16_t rgb565[PALETTE_MAX_SIZE];
+    uint32_t *cellStart;    // per coarse RGB cell: offset of its candidate list in cand
+    uint8_t *cand;          // candidate entry indices, concatenated
+} palette_t;
+
+// Porter-Duff operators for premultiplied ARGB32 / RGBA32 spans.
+typedef enum {
+    PD_CLEAR = 0,
+    PD_SRC,
+    PD_DST,
+    PD_SRC_OVER,
+    PD_DST_OVER,
+    PD_SRC_IN,
+    PD_DST_IN,
+    PD_SRC_OUT,
+    PD_DST_OUT,
+    PD_SRC_ATOP,
+    PD_DST_ATOP,
+    PD_XOR,
+    PD_PLUS,
+    PD_COUNT
+} porterduff_op_t;
+
+// Per-operator coefficients { a0, a_sa, a_da, b0, b_sa, b_da }, in enum order:
+// result = src * Fa + dst * Fb with Fa = a0 + a_sa * As + a_da * Ad (Fb alike),
+// all in 0..255. The one table behind both composite.c and colorutl.hpp.
+#define PORTERDUFF_COEF_INIT {                                                     \
+    {   0, 0,  0,    0,  0, 0 },  /* CLEAR */                                      \
+    { 255, 0,  0,    0,  0, 0 },  /* SRC */                                        \
+    {   0, 0,  0,  255,  0, 0 },  /* DST */                                        \
+    { 255, 0,  0,  255, -1, 0 },  /* SRC_OVER */                                   \
+    { 255, 0, -1,  255,  0, 0 },  /* DST_OVER */                                   \
+    {   0, 0,  1,    0,  0, 0 },  /* SRC_IN */                                     \
+    {   0, 0,  0,    0,  1, 0 },  /* DST_IN */                                     \
+    { 255, 0, -1,    0,  0, 0 },  /* SRC_OUT */                                    \
+    {   0, 0,  0,  255, -1, 0 },  /* DST_OUT */                                    \
+    {   0, 0,  1,  255, -1, 0 },  /* SRC_ATOP */                                   \
+    { 255, 0, -1,    0,  1, 0 },  /* DST_ATOP */                                   \
+    { 255, 0, -1,  255, -1, 0 },  /* XOR */                                        \
+    { 255, 0,  0,  255,  0, 0 },  /* PLUS */                                       \
+}
+
+typedef enum {
+    PIXFMT_ARGB32 = 0,  // ARGB32_t per pixel
+    PIXFMT_RGBA32,      // RGBA32_t per pixel
+    PIXFMT_RGB565,      // uint16_t per pixel
+    PIXFMT_RGB888,      // 3 bytes per pixel (r, g, b)
+    PIXFMT_F01,         // 3 floats per pixel (r, g, b), 0..1
+    PIXFMT_GRAY8,       // 1 byte per pixel
+    PIXFMT_GRAY1,       // 1 bit per pixel, MSB first, rows padded to a byte
+    PIXFMT_COUNT
+} pixfmt_t;
+
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// SIMD level picked once for the batch routines; RADIO_UTILS_CPU=scalar|sse2|avx2 lowers it.
+cpu_level_t cpuLevel(void);
+cpu_level_t cpuLevelSupported(void);
+const char *cpuLevelName(cpu_level_t level);
+
 void hsv2rgb(float h, float s, float v, float *r, float *g, float *b);
 void rgb2hsv(float r, float g, float b, float *h, float *s, float *v);
 void hsl2rgb(float h, float s, float l, float *r, float *g, float *b);
@@ -35,6 +139,37 @@ void rgb2hsl(float r, float g, float b, float *h, float *s, float *l);
 void hsv2hsl(float h, float s_hsv, float v, float *h_hsl, float *s_hsl, float *l);
 void hsl2hsv(float h, float s_hsl, float l, float *h_hsv, float *s_hsv, float *v);
 
+// Batch (SoA) conversions: n elements from the input arrays to the output arrays.
+// Hue may be any finite number of degrees and is wrapped into [0, 360); past
+// about 2^23 degrees float keeps no fraction, so only an in-range colour is
+// promised there. A NaN or infinite hue is treated as 0.
+void hsv2rgb_batch(const float *h, const float *s, const float *v, float *r, float *g, float *b, size_t n);
+void rgb2hsv_batch(const float *r, const float *g, const float *b, float *h, float *s, float *v, size_t n);
+void hsl2rgb_batch(const float *h, const float *s, const float *l, float *r, float *g, float *b, size_t n);
+void rgb2hsl_batch(const float *r, const float *g, const float *b, float *h, float *s, float *l, size_t n);
+
+// Fixed-point HSV/HSL for targets without an FPU (hsvfix.c). Hue is a fraction of a turn
+// (8-bit: 256 = 360 deg, 16-bit: 65536 = 360 deg); s, v and l are full scale at 255 / 65535.
+// Results are within one LSB of the float functions rounded to nearest.
+void hsv8_2rgb888(uint8_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b);
+uint16_t hsv8_2rgb565(uint8_t h, uint8_t s, uint8_t v);
+void hsl8_2rgb888(uint8_t h, uint8_t s, uint8_t l, uint8_t *r, uint8_t *g, uint8_t *b);
+uint16_t hsl8_2rgb565(uint8_t h, uint8_t s, uint8_t l);
+void hsv16_2rgb888(uint16_t h, uint16_t s, uint16_t v, uint8_t *r, uint8_t *g, uint8_t *b);
+uint16_t hsv16_2rgb565(uint16_t h, uint16_t s, uint16_t v);
+void hsl16_2rgb888(uint16_t h, uint16_t s, uint16_t l, uint8_t *r, uint8_t *g, uint8_t *b);
+uint16_t hsl16_2rgb565(uint16_t h, uint16_t s, uint16_t l);
+void rgb888_2hsv16(uint8_t r, uint8_t g, uint8_t b, uint16_t *h, uint16_t *s, uint16_t *v);
+void rgb888_2hsl16(uint8_t r, uint8_t g, uint8_t b, uint16_t *h, uint16_t *s, uint16_t *l);
+void rgb888_2hsv8(uint8_t r, uint8_t g, uint8_t b, uint8_t *h, uint8_t *s, uint8_t *v);
+void rgb888_2hsl8(uint8_t r, uint8_t g, uint8_t b, uint8_t *h, uint8_t *s, uint8_t *l);
+
+// LED strip batches: n interleaved (h, s, v) or (h, s, l) byte triplets to n pixels.
+void hsv8_2rgb888_batch(const uint8_t *hsv, uint8_t *rgb, size_t n);
+void hsv8_2rgb565_batch(const uint8_t *hsv, uint16_t *rgb565, size_t n);
+void hsl8_2rgb888_batch(const uint8_t *hsl, uint8_t *rgb, size_t n);
+void hsl8_2rgb565_batch(const uint8_t *hsl, uint16_t *rgb565, size_t n);
+
 uint8_t rgb2ansi256(uint8_t r, uint8_t g, uint8_t b);
 
 void rgb565_2f01(uint16_t rgb565, float *r, float *g, float *b);
@@ -54,6 +189,23 @@ ARGB32_t blend2argb32(ARGB32_t dst, ARGB32_t src);
 RGBA32_t blend2rgba32(RGBA32_t dst, RGBA32_t src);
 uint16_t rgb888_2rgb565(uint8_t r, uint8_t g, uint8_t b);
 
+// Premultiplied alpha: color channels scaled by alpha / 255.
+ARGB32_t premulARGB32(ARGB32_t argb);
+RGBA32_t premulRGBA32(RGBA32_t rgba);
+ARGB32_t unpremulARGB32(ARGB32_t argb);
+RGBA32_t unpremulRGBA32(RGBA32_t rgba);
+void premulSpanARGB32(ARGB32_t *dst, const ARGB32_t *src, size_t n);
+void premulSpanRGBA32(RGBA32_t *dst, const RGBA32_t *src, size_t n);
+void unpremulSpanARGB32(ARGB32_t *dst, const ARGB32_t *src, size_t n);
+void unpremulSpanRGBA32(RGBA32_t *dst, const RGBA32_t *src, size_t n);
+
+// dst = op(src, dst) over n pixels. Both spans must be premultiplied (no
+// colour channel above alpha) for the result to mean anything; other input
+// is not rejected, each channel just saturates at 255, and the result is
+// the same at every cpuLevel().
+void compositeSpanARGB32(porterduff_op_t op, ARGB32_t *dst, const ARGB32_t *src, size_t n);
+void compositeSpanRGBA32(porterduff_op_t op, RGBA32_t *dst, const RGBA32_t *src, size_t n);
+
 void rgb565_2rgb888(uint16_t rgb565, uint8_t* r, uint8_t* g, uint8_t* b); 
 
 uint8_t rgb565_2gray(uint16_t rgb565);
@@ -66,8 +218,42 @@ uint8_t applyGamma8(uint8_t value, float gamma);
 
 float applyGammaF(float value, float gamma);
 
+int colormapInit(colormap_t *cm, colormap_kind_t kind, uint16_t size, float min, float max);
+void colormapSetRange(colormap_t *cm, float min, float max);
+void colormapRowF32(const colormap_t *cm, const float *src, size_t n, colormap_out_t out, void *dst);
+void colormapRowI16(const colormap_t *cm, const int16_t *src, size_t n, colormap_out_t out, void *dst);
+void colormapRowI8(const colormap_t *cm, const int8_t *src, size_t n, colormap_out_t out, void *dst);
+
+// Builds a palette from n (1..256) r, g, b triplets; returns -1 on bad arguments
+// or when out of memory. Lookups use the weighted distance 2dr^2 + 4dg^2 + 3db^2
+// and return exactly what a brute-force search would, lower index on ties.
+// On a palette whose init failed (or was freed) paletteNearest returns 0 and
+// the Map functions leave dst untouched.
+int paletteInit(palette_t *pal, const uint8_t *rgb, size_t n);
+void paletteFree(palette_t *pal);
+uint8_t paletteNearest(const palette_t *pal, uint8_t r, uint8_t g, uint8_t b);
+// n pixels to n palette indices.
+void paletteMapRGB888(const palette_t *pal, const uint8_t *src, uint8_t *dst, size_t n);
+void paletteMapRGB565(const palette_t *pal, const uint16_t *src, uint8_t *dst, size_t n);
+// Floyd-Steinberg dithered width x height RGB888 image to palette indices; a
+// stride of 0 means tightly packed rows. Returns -1 on bad arguments or when out of memory.
+int paletteDitherRGB888(const palette_t *pal, uint8_t *dst, size_t dst_stride, const uint8_t *src, size_t src_stride,
+                        size_t width, size_t height);
+
+size_t pixfmtRowBytes(pixfmt_t fmt, size_t width);
+// Convert a width x height image; a stride of 0 means tightly packed rows.
+// dst may equal src when the destination pixels and stride are not larger.
+// RGB888 <-> RGB565 and RGB888 / RGB565 -> GRAY8 / GRAY1 rows use SSE2 or AVX2
+// per cpuLevel(); every level gives the same bytes.
+int pixconv(void *dst, pixfmt_t dst_fmt, size_t dst_stride,
+            const void *src, pixfmt_t src_fmt, size_t src_stride,
+            size_t width, size_t height);
+
 
 #ifdef __cplusplus
 }
 #endif
+
+#include "colorutl_inline.h"
+
 #endif // COLORUTL_H
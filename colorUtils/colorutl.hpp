@@ -0,0 +1,361 @@
+/*
+ * File:        colorUtils/colorutl.hpp
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Header-only C++14 layer over colorutl.h. Pixel types are templated on
+ *    their format (RGB565, RGB888, ARGB32, RGBA32, Gray8) and every
+ *    conversion, blend and palette helper is constexpr, so fixed colors,
+ *    gamma tables and palettes fold at compile time and hot loops inline
+ *    fully instead of calling through the weak-alias symbols.
+ *
+ *    Results are bit-identical to the C library: the float expressions are
+ *    written in the same order as the C sources (no FP contraction is
+ *    assumed on either side). gamma8() is the one exception, it uses a
+ *    double-precision constexpr pow() and matches applyGamma8() for the
+ *    usual gamma values (see test/colorutl_hpp_Test.cpp).
+ */
+
+#ifndef COLORUTL_HPP
+#define COLORUTL_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <limits>
+#include "colorutl.h"
+
+namespace colorutl {
+
+enum class Format { RGB565, RGB888, ARGB32, RGBA32, Gray8 };
+
+// Unpacked 8-bit channels, the common ground between formats.
+struct Rgba8 {
+    uint8_t r, g, b, a;
+};
+
+constexpr float clamp01(float x) {
+    return x < 0 ? 0 : (x > 1 ? 1 : x);
+}
+
+constexpr float fabs_c(float x) {
+    return x < 0 ? -x : x;
+}
+
+constexpr uint8_t gray8(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint8_t)((r * 0.299f) + (g * 0.587f) + (b * 0.114f) + 0.5f);
+}
+
+template <Format F> struct Pixel;
+
+template <> struct Pixel<Format::RGB565> {
+    uint16_t v;
+    constexpr Rgba8 rgba() const {
+        return Rgba8{ (uint8_t)(((v >> 11) & 0x1F) << 3), (uint8_t)(((v >> 5) & 0x3F) << 2),
+                      (uint8_t)((v & 0x1F) << 3), 0xFF };
+    }
+    static constexpr Pixel from(Rgba8 c) {
+        return Pixel{ (uint16_t)(((c.r & 0xF8) << 8) | ((c.g & 0xFC) << 3) | (c.b >> 3)) };
+    }
+    constexpr uint8_t gray() const {
+        return gray8((uint8_t)(((v >> 11) & 0x1F) << 3), (uint8_t)(((v >> 5) & 0x3F) << 2), (uint8_t)((v & 0x1F) << 3));
+    }
+};
+
+template <> struct Pixel<Format::RGB888> {
+    uint8_t r, g, b;
+    constexpr Rgba8 rgba() const { return Rgba8{ r, g, b, 0xFF }; }
+    static constexpr Pixel from(Rgba8 c) { return Pixel{ c.r, c.g, c.b }; }
+    constexpr uint8_t gray() const { return gray8(r, g, b); }
+};
+
+template <> struct Pixel<Format::ARGB32> {
+    ARGB32_t v;
+    constexpr Rgba8 rgba() const {
+        return Rgba8{ (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v, (uint8_t)(v >> 24) };
+    }
+    static constexpr Pixel from(Rgba8 c) {
+        return Pixel{ ((uint32_t)c.a << 24) | ((uint32_t)c.r << 16) | ((uint32_t)c.g << 8) | c.b };
+    }
+    constexpr uint8_t gray() const { return gray8((uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v); }
+};
+
+template <> struct Pixel<Format::RGBA32> {
+    RGBA32_t v;
+    constexpr Rgba8 rgba() const {
+        return Rgba8{ (uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v };
+    }
+    static constexpr Pixel from(Rgba8 c) {
+        return Pixel{ ((uint32_t)c.r << 24) | ((uint32_t)c.g << 16) | ((uint32_t)c.b << 8) | c.a };
+    }
+    constexpr uint8_t gray() const { return gray8((uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8)); }
+};
+
+template <> struct Pixel<Format::Gray8> {
+    uint8_t v;
+    constexpr Rgba8 rgba() const { return Rgba8{ v, v, v, 0xFF }; }
+    static constexpr Pixel from(Rgba8 c) { return Pixel{ gray8(c.r, c.g, c.b) }; }
+    constexpr uint8_t gray() const { return v; }
+};
+
+using RGB565 = Pixel<Format::RGB565>;
+using RGB888 = Pixel<Format::RGB888>;
+using ARGB32 = Pixel<Format::ARGB32>;
+using RGBA32 = Pixel<Format::RGBA32>;
+using Gray8  = Pixel<Format::Gray8>;
+
+namespace detail {
+
+template <Format To, Format From>
+struct Converter {
+    static constexpr Pixel<To> run(Pixel<From> p) { return Pixel<To>::from(p.rgba()); }
+};
+
+template <Format F>
+struct Converter<F, F> {
+    static constexpr Pixel<F> run(Pixel<F> p) { return p; }
+};
+
+} // namespace detail
+
+// Format conversion, same results as rgb888_2rgb565 / rgb565_2rgb888 / rgb*_2gray / pixconv.
+template <Format To, Format From>
+constexpr Pixel<To> convert(Pixel<From> p) {
+    return detail::Converter<To, From>::run(p);
+}
+
+constexpr uint8_t gray2_1bit(uint8_t gray) {
+    return gray >= 128 ? 1 : 0;
+}
+
+constexpr uint8_t rgb2ansi256(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint8_t)(16 + 36 * (uint8_t)(r * 5 / 255) + 6 * (uint8_t)(g * 5 / 255) + (uint8_t)(b * 5 / 255));
+}
+
+template <Format F>
+constexpr uint8_t ansi256(Pixel<F> p) {
+    return rgb2ansi256(p.rgba().r, p.rgba().g, p.rgba().b);
+}
+
+// --- float <-> integer (f01_2rgb888, f01_2rgb565, rgb888_2f01, rgb565_2f01) ---
+
+struct RgbF {
+    float r, g, b;
+};
+
+constexpr RGB888 f01_2rgb888(float r, float g, float b) {
+    return RGB888{ (uint8_t)(clamp01(r) * 255 + 0.5f), (uint8_t)(clamp01(g) * 255 + 0.5f),
+                   (uint8_t)(clamp01(b) * 255 + 0.5f) };
+}
+
+constexpr RGB565 f01_2rgb565(float r, float g, float b) {
+    return RGB565{ (uint16_t)(((uint8_t)(clamp01(r) * 31 + 0.5f) << 11) |
+                              ((uint8_t)(clamp01(g) * 63 + 0.5f) << 5) |
+                              (uint8_t)(clamp01(b) * 31 + 0.5f)) };
+}
+
+constexpr RgbF rgb888_2f01(RGB888 p) {
+    return RgbF{ p.r / 255.0f, p.g / 255.0f, p.b / 255.0f };
+}
+
+constexpr RgbF rgb565_2f01(RGB565 p) {
+    return RgbF{ ((p.v >> 11) & 0x1F) / 31.0f, ((p.v >> 5) & 0x3F) / 63.0f, (p.v & 0x1F) / 31.0f };
+}
+
+// --- HSV / HSL (hsv2rgb, hsl2rgb) ---
+
+namespace detail {
+
+// fmodf(x, y) for finite y > 0, with the libm result: the sign of x, NaN for
+// a NaN or infinite x. Each step takes off the largest y * 2^k that fits,
+// and that subtraction is exact (t <= r < 2t).
+constexpr float fmod_c(float x, float y) {
+    if (x != x || fabs_c(x) > std::numeric_limits<float>::max()) return std::numeric_limits<float>::quiet_NaN();
+    float r = fabs_c(x);
+    while (r >= y) {
+        float t = y;
+        while (t <= r / 2) t *= 2;
+        r -= t;
+    }
+    return (x < 0) ? -r : (x == 0 ? x : r);
+}
+
+constexpr RgbF sector(float h, float c, float x, float m) {
+    return (h < 60)  ? RgbF{ c + m, x + m, 0 + m } :
+           (h < 120) ? RgbF{ x + m, c + m, 0 + m } :
+           (h < 180) ? RgbF{ 0 + m, c + m, x + m } :
+           (h < 240) ? RgbF{ 0 + m, x + m, c + m } :
+           (h < 300) ? RgbF{ x + m, 0 + m, c + m } :
+                       RgbF{ c + m, 0 + m, x + m };
+}
+
+} // namespace detail
+
+constexpr RgbF hsv2rgb(float h, float s, float v) {
+    h = detail::fmod_c(h, 360.0f);
+    s = clamp01(s);
+    v = clamp01(v);
+    float c = v * s;
+    float x = c * (1 - fabs_c(detail::fmod_c(h / 60.0f, 2) - 1));
+    return detail::sector(h, c, x, v - c);
+}
+
+constexpr RgbF hsl2rgb(float h, float s, float l) {
+    h = detail::fmod_c(h, 360.0f);
+    s = clamp01(s);
+    l = clamp01(l);
+    float c = (1 - fabs_c(2 * l - 1)) * s;
+    float x = c * (1 - fabs_c(detail::fmod_c(h / 60.0f, 2) - 1));
+    return detail::sector(h, c, x, l - c / 2);
+}
+
+// --- blends (blend2rgb565, blend2rgb888, blend2argb32, blend2rgba32) ---
+
+namespace detail {
+
+constexpr uint8_t mix(int bg, int fg, float alpha) {
+    return (uint8_t)(((bg) * (1 - (alpha)) + (fg) * (alpha)) + 0.5f);
+}
+
+} // namespace detail
+
+constexpr RGB565 blend(RGB565 bg, RGB565 fg, uint8_t a8) {
+    return RGB565{ (uint16_t)((detail::mix((bg.v >> 11) & 0x1F, (fg.v >> 11) & 0x1F, a8 / 255.0f) << 11) |
+                              (detail::mix((bg.v >> 5) & 0x3F, (fg.v >> 5) & 0x3F, a8 / 255.0f) << 5) |
+                              detail::mix(bg.v & 0x1F, fg.v & 0x1F, a8 / 255.0f)) };
+}
+
+constexpr RGB888 blend(RGB888 bg, RGB888 fg, uint8_t a8) {
+    return RGB888{ detail::mix(bg.r, fg.r, a8 / 255.0f), detail::mix(bg.g, fg.g, a8 / 255.0f),
+                   detail::mix(bg.b, fg.b, a8 / 255.0f) };
+}
+
+template <Format F>
+constexpr Pixel<F> blend(Pixel<F> dst, Pixel<F> src) {
+    return Pixel<F>::from(Rgba8{ detail::mix(dst.rgba().r, src.rgba().r, src.rgba().a / 255.0f),
+                                 detail::mix(dst.rgba().g, src.rgba().g, src.rgba().a / 255.0f),
+                                 detail::mix(dst.rgba().b, src.rgba().b, src.rgba().a / 255.0f),
+                                 0xFF });
+}
+
+// --- premultiplied alpha and Porter-Duff (premulARGB32, compositeSpanARGB32, ...) ---
+
+namespace detail {
+
+constexpr uint32_t div255(uint32_t x) {
+    return ((x + 128) + ((x + 128) >> 8)) >> 8;
+}
+
+constexpr uint8_t sat(uint32_t x) {
+    return (uint8_t)(x > 255 ? 255 : x);
+}
+
+constexpr uint8_t unpremul(uint8_t c, uint8_t a) {
+    return sat(((uint32_t)c * 255 + a / 2) / a);
+}
+
+// {Fa, Fb} coefficients: F = c0 + c_sa * As + c_da * Ad, the table composite.c uses.
+constexpr int PD_COEF[][6] = PORTERDUFF_COEF_INIT;
+static_assert(sizeof(PD_COEF) / sizeof(PD_COEF[0]) == PD_COUNT, "one row per porterduff_op_t");
+
+constexpr uint8_t pd_chan(porterduff_op_t op, uint8_t s, uint8_t d, uint32_t fa, uint32_t fb) {
+    return op == PD_PLUS ? sat((uint32_t)s + d) : sat(div255(s * fa + d * fb));
+}
+
+constexpr Rgba8 pd(porterduff_op_t op, Rgba8 d, Rgba8 s, uint32_t fa, uint32_t fb) {
+    return Rgba8{ pd_chan(op, s.r, d.r, fa, fb), pd_chan(op, s.g, d.g, fa, fb),
+                  pd_chan(op, s.b, d.b, fa, fb), pd_chan(op, s.a, d.a, fa, fb) };
+}
+
+} // namespace detail
+
+template <Format F>
+constexpr Pixel<F> premul(Pixel<F> p) {
+    return Pixel<F>::from(Rgba8{ (uint8_t)detail::div255((uint32_t)p.rgba().r * p.rgba().a),
+                                 (uint8_t)detail::div255((uint32_t)p.rgba().g * p.rgba().a),
+                                 (uint8_t)detail::div255((uint32_t)p.rgba().b * p.rgba().a),
+                                 p.rgba().a });
+}
+
+template <Format F>
+constexpr Pixel<F> unpremul(Pixel<F> p) {
+    return p.rgba().a == 0   ? Pixel<F>::from(Rgba8{ 0, 0, 0, 0 }) :
+           p.rgba().a == 255 ? p :
+           Pixel<F>::from(Rgba8{ detail::unpremul(p.rgba().r, p.rgba().a), detail::unpremul(p.rgba().g, p.rgba().a),
+                                 detail::unpremul(p.rgba().b, p.rgba().a), p.rgba().a });
+}
+
+// dst = op(src, dst) for one premultiplied pixel.
+template <Format F>
+constexpr Pixel<F> composite(porterduff_op_t op, Pixel<F> dst, Pixel<F> src) {
+    return Pixel<F>::from(detail::pd(op, dst.rgba(), src.rgba(),
+        (uint32_t)(detail::PD_COEF[op][0] + detail::PD_COEF[op][1] * src.rgba().a + detail::PD_COEF[op][2] * dst.rgba().a),
+        (uint32_t)(detail::PD_COEF[op][3] + detail::PD_COEF[op][4] * src.rgba().a + detail::PD_COEF[op][5] * dst.rgba().a)));
+}
+
+// --- gamma (applyGamma8) ---
+
+namespace detail {
+
+constexpr double exp_c(double x) {
+    // e^x = (e^(x / 2^k))^(2^k) with a short Taylor series for the small part.
+    double y = x / 1024.0, term = 1.0, sum = 1.0;
+    for (int i = 1; i < 16; i++) {
+        term *= y / i;
+        sum += term;
+    }
+    for (int i = 0; i < 10; i++) sum *= sum;
+    return sum;
+}
+
+constexpr double ln_c(double x) {
+    // ln(x) = 2 atanh((x - 1) / (x + 1)) after scaling x into [0.5, 1].
+    int k = 0;
+    while (x < 0.5) { x *= 2; k--; }
+    double z = (x - 1) / (x + 1), z2 = z * z, term = z, sum = 0;
+    for (int i = 1; i < 60; i += 2) {
+        sum += term / i;
+        term *= z2;
+    }
+    return 2 * sum + k * 0.69314718055994530942;
+}
+
+constexpr double pow_c(double x, double y) {
+    return x <= 0 ? (y == 0 ? 1.0 : 0.0) : exp_c(y * ln_c(x));
+}
+
+} // namespace detail
+
+constexpr uint8_t gamma8(uint8_t value, float gamma) {
+    return (uint8_t)((float)detail::pow_c(value / 255.0f, gamma) * 255.0f + 0.5f);
+}
+
+// --- compile-time tables ---
+
+template <typename T, size_t N>
+struct Table {
+    T v[N];
+    constexpr const T &operator[](size_t i) const { return v[i]; }
+    constexpr size_t size() const { return N; }
+};
+
+// Table<T, N> with v[i] = f(i), evaluated at compile time when used in a constexpr
+// context. f must be a literal callable (a constexpr lambda needs C++17).
+template <typename T, size_t N, typename Fn>
+constexpr Table<T, N> makeTable(Fn f) {
+    Table<T, N> t{};
+    for (size_t i = 0; i < N; i++) t.v[i] = f(i);
+    return t;
+}
+
+template <size_t N = 256>
+constexpr Table<uint8_t, N> gammaTable(float gamma) {
+    Table<uint8_t, N> t{};
+    for (size_t i = 0; i < N; i++) t.v[i] = gamma8((uint8_t)i, gamma);
+    return t;
+}
+
+} // namespace colorutl
+
+#endif // COLORUTL_HPP
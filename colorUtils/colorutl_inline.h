@@ -0,0 +1,137 @@
+#ifndef COLORUTL_INLINE_H
+#define COLORUTL_INLINE_H
+
+#include <stdint.h>
+
+// static inline bodies of the trivial per-pixel conversions. The library
+// exports are built from these same bodies, so results are identical.
+//
+// Define COLORUTL_INLINE before including colorutl.h (or pass -DCOLORUTL_INLINE)
+// to route the plain names to these versions in C code, so hot loops can inline
+// them. Taking a function's address (no call parentheses) still gets the
+// exported symbol. The *_inline names are always available.
+
+#ifndef CLAMP01
+#define CLAMP01(x) ((float)(x) < 0 ? 0 : ((float)(x) > 1 ? 1 : (float)(x)))
+#endif
+
+#ifndef ALPHA_MIX
+#define ALPHA_MIX(a, b, alpha) ((a) * (1 - (alpha)) + (b) * (alpha))
+#endif
+
+static inline uint16_t rgb888_2rgb565_inline(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) |
+           ((g & 0xFC) << 3) |
+           (b >> 3);
+}
+
+static inline void rgb565_2rgb888_inline(uint16_t rgb565, uint8_t *r, uint8_t *g, uint8_t *b) {
+    *r = ((rgb565 >> 11) & 0x1F) << 3;
+    *g = ((rgb565 >> 5)  & 0x3F) << 2;
+    *b = (rgb565 & 0x1F) << 3;
+}
+
+static inline uint8_t rgb888_2gray_inline(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint8_t)((r * 0.299f) + (g * 0.587f) + (b * 0.114f) + 0.5f);
+}
+
+static inline uint8_t rgb565_2gray_inline(uint16_t rgb565) {
+    uint8_t r = ((rgb565 >> 11) & 0x1F) << 3;  // 5-bit to 8-bit
+    uint8_t g = ((rgb565 >> 5) & 0x3F) << 2;   // 6-bit to 8-bit
+    uint8_t b = (rgb565 & 0x1F) << 3;          // 5-bit to 8-bit
+    return rgb888_2gray_inline(r, g, b);
+}
+
+static inline uint8_t gray2_1bit_inline(uint8_t gray) {
+    return gray >= 128 ? 1 : 0;
+}
+
+static inline uint8_t rgb2ansi256_inline(uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t ir = r * 5 / 255;
+    uint8_t ig = g * 5 / 255;
+    uint8_t ib = b * 5 / 255;
+    return 16 + 36 * ir + 6 * ig + ib;
+}
+
+static inline void rgb565_2f01_inline(uint16_t rgb565, float *r, float *g, float *b) {
+    *r = ((rgb565 >> 11) & 0x1F) / 31.0f;
+    *g = ((rgb565 >> 5)  & 0x3F) / 63.0f;
+    *b = (rgb565 & 0x1F) / 31.0f;
+}
+
+static inline uint16_t f01_2rgb565_inline(float r, float g, float b) {
+    uint8_t R = (uint8_t)(CLAMP01(r) * 31 + 0.5f);
+    uint8_t G = (uint8_t)(CLAMP01(g) * 63 + 0.5f);
+    uint8_t B = (uint8_t)(CLAMP01(b) * 31 + 0.5f);
+    return (R << 11) | (G << 5) | B;
+}
+
+static inline void rgb888_2f01_inline(uint8_t r8, uint8_t g8, uint8_t b8, float *r, float *g, float *b) {
+    *r = r8 / 255.0f;
+    *g = g8 / 255.0f;
+    *b = b8 / 255.0f;
+}
+
+static inline void f01_2rgb888_inline(float r, float g, float b, uint8_t *r8, uint8_t *g8, uint8_t *b8) {
+    *r8 = (uint8_t)(CLAMP01(r) * 255 + 0.5f);
+    *g8 = (uint8_t)(CLAMP01(g) * 255 + 0.5f);
+    *b8 = (uint8_t)(CLAMP01(b) * 255 + 0.5f);
+}
+
+static inline uint16_t blend2rgb565_inline(uint16_t bg, uint16_t fg, uint8_t a8) {
+    float alpha = a8 / 255.0f;
+    uint8_t r = (uint8_t)(ALPHA_MIX(((bg >> 11) & 0x1F), ((fg >> 11) & 0x1F), alpha) + 0.5f);
+    uint8_t g = (uint8_t)(ALPHA_MIX(((bg >> 5)  & 0x3F), ((fg >> 5)  & 0x3F), alpha) + 0.5f);
+    uint8_t b = (uint8_t)(ALPHA_MIX((bg & 0x1F), (fg & 0x1F), alpha) + 0.5f);
+    return (r << 11) | (g << 5) | b;
+}
+
+static inline void blend2rgb888_inline(uint8_t bg_r, uint8_t bg_g, uint8_t bg_b,
+                                       uint8_t fg_r, uint8_t fg_g, uint8_t fg_b,
+                                       uint8_t a8,
+                                       uint8_t *out_r, uint8_t *out_g, uint8_t *out_b) {
+    float alpha = a8 / 255.0f;
+    *out_r = (uint8_t)(ALPHA_MIX(bg_r, fg_r, alpha) + 0.5f);
+    *out_g = (uint8_t)(ALPHA_MIX(bg_g, fg_g, alpha) + 0.5f);
+    *out_b = (uint8_t)(ALPHA_MIX(bg_b, fg_b, alpha) + 0.5f);
+}
+
+static inline uint32_t blend2argb32_inline(uint32_t dst, uint32_t src) {
+    uint8_t a = (src >> 24) & 0xFF;
+    float alpha = a / 255.0f;
+    uint8_t r = (uint8_t)(ALPHA_MIX(((dst >> 16) & 0xFF), ((src >> 16) & 0xFF), alpha) + 0.5f);
+    uint8_t g = (uint8_t)(ALPHA_MIX(((dst >> 8) & 0xFF), ((src >> 8) & 0xFF), alpha) + 0.5f);
+    uint8_t b = (uint8_t)(ALPHA_MIX((dst & 0xFF), (src & 0xFF), alpha) + 0.5f);
+    return (0xFFu << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+static inline uint32_t blend2rgba32_inline(uint32_t dst, uint32_t src) {
+    uint8_t a = src & 0xFF;
+    float alpha = a / 255.0f;
+    uint8_t r = (uint8_t)(ALPHA_MIX(((dst >> 24) & 0xFF), ((src >> 24) & 0xFF), alpha) + 0.5f);
+    uint8_t g = (uint8_t)(ALPHA_MIX(((dst >> 16) & 0xFF), ((src >> 16) & 0xFF), alpha) + 0.5f);
+    uint8_t b = (uint8_t)(ALPHA_MIX(((dst >> 8) & 0xFF), ((src >> 8) & 0xFF), alpha) + 0.5f);
+    return ((uint32_t)r << 24) | ((uint32_t)g << 16) | ((uint32_t)b << 8) | 0xFFu;
+}
+
+
+// C only: colorutl.hpp has constexpr functions with some of these names.
+#if defined(COLORUTL_INLINE) && !defined(__cplusplus)
+#define rgb888_2rgb565(r, g, b)            rgb888_2rgb565_inline(r, g, b)
+#define rgb565_2rgb888(c, r, g, b)         rgb565_2rgb888_inline(c, r, g, b)
+#define rgb888_2gray(r, g, b)              rgb888_2gray_inline(r, g, b)
+#define rgb565_2gray(c)                    rgb565_2gray_inline(c)
+#define gray2_1bit(gray)                   gray2_1bit_inline(gray)
+#define rgb2ansi256(r, g, b)               rgb2ansi256_inline(r, g, b)
+#define rgb565_2f01(c, r, g, b)            rgb565_2f01_inline(c, r, g, b)
+#define f01_2rgb565(r, g, b)               f01_2rgb565_inline(r, g, b)
+#define rgb888_2f01(r8, g8, b8, r, g, b)   rgb888_2f01_inline(r8, g8, b8, r, g, b)
+#define f01_2rgb888(r, g, b, r8, g8, b8)   f01_2rgb888_inline(r, g, b, r8, g8, b8)
+#define blend2rgb565(bg, fg, a8)           blend2rgb565_inline(bg, fg, a8)
+#define blend2rgb888(br, bgg, bb, fr, fg, fb, a8, r, g, b) \
+    blend2rgb888_inline(br, bgg, bb, fr, fg, fb, a8, r, g, b)
+#define blend2argb32(dst, src)             blend2argb32_inline(dst, src)
+#define blend2rgba32(dst, src)             blend2rgba32_inline(dst, src)
+#endif
+
+#endif // COLORUTL_INLINE_H
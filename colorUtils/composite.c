@@ -0,0 +1,339 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "colorutl.h"
+#include <statUtils/statutl.h>
+#include "cpulevel.h"
+
+// Premultiplied-alpha Porter-Duff compositing for ARGB32 / RGBA32 spans.
+//
+// Every operator is result = src * Fa + dst * Fb, applied to all four
+// premultiplied channels, with Fa / Fb = c0 + c1 * As + c2 * Ad in 0..255
+// and one rounded division by 255 per channel, clamped to 255 when the input
+// is not actually premultiplied. PLUS is a saturating add. The span bodies
+// run on SSE2 (4 pixels) or AVX2 (8 pixels) as cpuLevel() allows; every
+// level produces identical bytes for any input.
+
+typedef struct {
+    int16_t a0, a_sa, a_da; // Fa = a0 + a_sa * As + a_da * Ad
+    int16_t b0, b_sa, b_da; // Fb = b0 + b_sa * As + b_da * Ad
+} porterduff_coef_t;
+
+static const porterduff_coef_t PORTERDUFF_COEF[] = PORTERDUFF_COEF_INIT;
+// Does not compile unless PORTERDUFF_COEF_INIT has one row per operator.
+typedef char porterduff_coef_count_check[sizeof(PORTERDUFF_COEF) / sizeof(PORTERDUFF_COEF[0]) == PD_COUNT ? 1 : -1];
+
+// Rounded x / 255 for x in 0..65025.
+static inline uint32_t div255(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Alpha sits in bits 24..31 for ARGB32 and bits 0..7 for RGBA32.
+static inline uint32_t alpha_of(uint32_t px, int rgba) {
+    return rgba ? (px & 0xFF) : (px >> 24);
+}
+
+static inline uint32_t premul_1(uint32_t px, int rgba) {
+    uint32_t a = alpha_of(px, rgba);
+    int ashift = rgba ? 0 : 24;
+    uint32_t out = a << ashift;
+    for (int shift = 0; shift < 32; shift += 8) {
+        if (shift == ashift) continue;
+        out |= div255(((px >> shift) & 0xFF) * a) << shift;
+    }
+    return out;
+}
+
+static inline uint32_t unpremul_1(uint32_t px, int rgba) {
+    uint32_t a = alpha_of(px, rgba);
+    int ashift = rgba ? 0 : 24;
+    if (a == 0) return 0;
+    if (a == 255) return px;
+    uint32_t out = a << ashift;
+    for (int shift = 0; shift < 32; shift += 8) {
+        if (shift == ashift) continue;
+        uint32_t c = (((px >> shift) & 0xFF) * 255 + a / 2) / a;
+        out |= (c > 255 ? 255 : c) << shift;
+    }
+    return out;
+}
+
+static inline uint32_t composite_1(const porterduff_coef_t *k, uint32_t d, uint32_t s, int rgba) {
+    uint32_t sa = alpha_of(s, rgba), da = alpha_of(d, rgba);
+    uint32_t fa = (uint32_t)(k->a0 + k->a_sa * (int)sa + k->a_da * (int)da);
+    uint32_t fb = (uint32_t)(k->b0 + k->b_sa * (int)sa + k->b_da * (int)da);
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t c = div255(((s >> shift) & 0xFF) * fa + ((d >> shift) & 0xFF) * fb);
+        out |= (c > 255 ? 255 : c) << shift;
+    }
+    return out;
+}
+
+static inline uint32_t plus_1(uint32_t d, uint32_t s) {
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t c = ((s >> shift) & 0xFF) + ((d >> shift) & 0xFF);
+        out |= (c > 255 ? 255 : c) << shift;
+    }
+    return out;
+}
+
+#if defined(__SSE2__)
+
+// Each product fits in 16 bits, their sum only for premultiplied input:
+// saturate it, then clamp to 255 * 255 so div255 gives 255 like the scalar
+// path. min(x, c) is x - max(x - c, 0).
+static inline __m128i sum_clamp_sse2(__m128i a, __m128i b) {
+    __m128i x = _mm_adds_epu16(a, b);
+    return _mm_sub_epi16(x, _mm_subs_epu16(x, _mm_set1_epi16((short)65025)));
+}
+
+static inline __m128i div255_sse2(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Broadcast each pixel's alpha over its four 16-bit lanes (two pixels per register).
+static inline __m128i alpha16_sse2(__m128i px16, int rgba) {
+    return rgba ? _mm_shufflehi_epi16(_mm_shufflelo_epi16(px16, 0x00), 0x00)
+                : _mm_shufflehi_epi16(_mm_shufflelo_epi16(px16, 0xFF), 0xFF);
+}
+
+static inline __m128i alpha_lane_mask(int rgba) {
+    return rgba ? _mm_set_epi16(0, 0, 0, -1, 0, 0, 0, -1)
+                : _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+}
+
+static inline __m128i premul16_sse2(__m128i px16, int rgba) {
+    __m128i amask = alpha_lane_mask(rgba);
+    __m128i a = alpha16_sse2(px16, rgba);
+    __m128i m = _mm_or_si128(_mm_andnot_si128(amask, a), _mm_and_si128(amask, _mm_set1_epi16(255)));
+    return div255_sse2(_mm_mullo_epi16(px16, m));
+}
+
+static void premul_span_sse2(uint32_t *dst, const uint32_t *src, size_t n, int rgba, size_t *done) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i lo = premul16_sse2(_mm_unpacklo_epi8(px, zero), rgba);
+        __m128i hi = premul16_sse2(_mm_unpackhi_epi8(px, zero), rgba);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    *done = i;
+}
+
+static inline __m128i factor16_sse2(int16_t c0, int16_t c_sa, int16_t c_da, __m128i sa, __m128i da) {
+    return _mm_add_epi16(_mm_set1_epi16(c0),
+                         _mm_add_epi16(_mm_mullo_epi16(sa, _mm_set1_epi16(c_sa)),
+                                       _mm_mullo_epi16(da, _mm_set1_epi16(c_da))));
+}
+
+static inline __m128i composite16_sse2(const porterduff_coef_t *k, __m128i d16, __m128i s16, int rgba) {
+    __m128i sa = alpha16_sse2(s16, rgba), da = alpha16_sse2(d16, rgba);
+    __m128i fa = factor16_sse2(k->a0, k->a_sa, k->a_da, sa, da);
+    __m128i fb = factor16_sse2(k->b0, k->b_sa, k->b_da, sa, da);
+    return div255_sse2(sum_clamp_sse2(_mm_mullo_epi16(s16, fa), _mm_mullo_epi16(d16, fb)));
+}
+
+static void composite_span_sse2(porterduff_op_t op, uint32_t *dst, const uint32_t *src, size_t n,
+                                int rgba, size_t *done) {
+    const porterduff_coef_t *k = &PORTERDUFF_COEF[op];
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i out;
+        if (op == PD_PLUS) {
+            out = _mm_adds_epu8(s, d);
+        } else {
+            __m128i lo = composite16_sse2(k, _mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), rgba);
+            __m128i hi = composite16_sse2(k, _mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), rgba);
+            out = _mm_packus_epi16(lo, hi);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), out);
+    }
+    *done = i;
+}
+
+#endif // __SSE2__
+
+#if COLORUTL_X86_DISPATCH
+
+AVX2_FN __m256i sum_clamp_avx2(__m256i a, __m256i b) {
+    __m256i x = _mm256_adds_epu16(a, b);
+    return _mm256_sub_epi16(x, _mm256_subs_epu16(x, _mm256_set1_epi16((short)65025)));
+}
+
+AVX2_FN __m256i div255_avx2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+AVX2_FN __m256i alpha16_avx2(__m256i px16, int rgba) {
+    return rgba ? _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(px16, 0x00), 0x00)
+                : _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(px16, 0xFF), 0xFF);
+}
+
+AVX2_FN __m256i premul16_avx2(__m256i px16, int rgba) {
+    __m256i amask = rgba ? _mm256_set1_epi64x(0x000000000000FFFFLL) : _mm256_set1_epi64x((long long)0xFFFF000000000000ULL);
+    __m256i a = alpha16_avx2(px16, rgba);
+    __m256i m = _mm256_or_si256(_mm256_andnot_si256(amask, a), _mm256_and_si256(amask, _mm256_set1_epi16(255)));
+    return div255_avx2(_mm256_mullo_epi16(px16, m));
+}
+
+// Unpack / pack work per 128-bit lane, so pixel order survives the round trip.
+__attribute__((target("avx2")))
+static void premul_span_avx2(uint32_t *dst, const uint32_t *src, size_t n, int rgba, size_t *done) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i px = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i lo = premul16_avx2(_mm256_unpacklo_epi8(px, zero), rgba);
+        __m256i hi = premul16_avx2(_mm256_unpackhi_epi8(px, zero), rgba);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    *done = i;
+}
+
+AVX2_FN __m256i factor16_avx2(int16_t c0, int16_t c_sa, int16_t c_da, __m256i sa, __m256i da) {
+    return _mm256_add_epi16(_mm256_set1_epi16(c0),
+                            _mm256_add_epi16(_mm256_mullo_epi16(sa, _mm256_set1_epi16(c_sa)),
+                                             _mm256_mullo_epi16(da, _mm256_set1_epi16(c_da))));
+}
+
+AVX2_FN __m256i composite16_avx2(const porterduff_coef_t *k, __m256i d16, __m256i s16, int rgba) {
+    __m256i sa = alpha16_avx2(s16, rgba), da = alpha16_avx2(d16, rgba);
+    __m256i fa = factor16_avx2(k->a0, k->a_sa, k->a_da, sa, da);
+    __m256i fb = factor16_avx2(k->b0, k->b_sa, k->b_da, sa, da);
+    return div255_avx2(sum_clamp_avx2(_mm256_mullo_epi16(s16, fa), _mm256_mullo_epi16(d16, fb)));
+}
+
+__attribute__((target("avx2")))
+static void composite_span_avx2(porterduff_op_t op, uint32_t *dst, const uint32_t *src, size_t n,
+                                int rgba, size_t *done) {
+    const porterduff_coef_t *k = &PORTERDUFF_COEF[op];
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        __m256i out;
+        if (op == PD_PLUS) {
+            out = _mm256_adds_epu8(s, d);
+        } else {
+            __m256i lo = composite16_avx2(k, _mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(s, zero), rgba);
+            __m256i hi = composite16_avx2(k, _mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(s, zero), rgba);
+            out = _mm256_packus_epi16(lo, hi);
+        }
+        _mm256_storeu_si256((__m256i *)(dst + i), out);
+    }
+    *done = i;
+}
+
+#endif // COLORUTL_X86_DISPATCH
+
+// Vector span bodies for the active level; NULL leaves the whole span to the scalar loop.
+typedef struct {
+    void (*premul)(uint32_t *dst, const uint32_t *src, size_t n, int rgba, size_t *done);
+    void (*composite)(porterduff_op_t op, uint32_t *dst, const uint32_t *src, size_t n, int rgba, size_t *done);
+} composite_impl_t;
+
+static const composite_impl_t COMPOSITE_SCALAR = { NULL, NULL };
+#if defined(__SSE2__)
+static const composite_impl_t COMPOSITE_SSE2 = { premul_span_sse2, composite_span_sse2 };
+#endif
+#if COLORUTL_X86_DISPATCH
+static const composite_impl_t COMPOSITE_AVX2 = { premul_span_avx2, composite_span_avx2 };
+#endif
+
+static const composite_impl_t *composite_impl(void) {
+    return CPU_LEVEL_DISPATCH(const composite_impl_t *, &COMPOSITE_SCALAR, &COMPOSITE_SSE2, &COMPOSITE_AVX2);
+}
+
+static inline void premul_span(uint32_t *dst, const uint32_t *src, size_t n, int rgba) {
+    const composite_impl_t *impl = composite_impl();
+    size_t i = 0;
+    if (impl->premul) impl->premul(dst, src, n, rgba, &i);
+    for (; i < n; i++) dst[i] = premul_1(src[i], rgba);
+}
+
+static inline void composite_span(porterduff_op_t op, uint32_t *dst, const uint32_t *src, size_t n, int rgba) {
+    if ((unsigned)op >= PD_COUNT) return;
+    const composite_impl_t *impl = composite_impl();
+    size_t i = 0;
+    if (impl->composite) impl->composite(op, dst, src, n, rgba, &i);
+    if (op == PD_PLUS) {
+        for (; i < n; i++) dst[i] = plus_1(dst[i], src[i]);
+    } else {
+        for (; i < n; i++) dst[i] = composite_1(&PORTERDUFF_COEF[op], dst[i], src[i], rgba);
+    }
+}
+
+static ARGB32_t __p_R_e_M_u_L_a_R_g_B_3_2__(ARGB32_t argb) {
+    return premul_1(argb, 0);
+}
+
+static RGBA32_t __p_R_e_M_u_L_r_G_b_A_3_2__(RGBA32_t rgba) {
+    return premul_1(rgba, 1);
+}
+
+static ARGB32_t __u_N_p_R_e_M_u_L_a_R_g_B_3_2__(ARGB32_t argb) {
+    return unpremul_1(argb, 0);
+}
+
+static RGBA32_t __u_N_p_R_e_M_u_L_r_G_b_A_3_2__(RGBA32_t rgba) {
+    return unpremul_1(rgba, 1);
+}
+
+static void __p_R_e_M_u_L_s_P_a_N_a_R_g_B_3_2__(ARGB32_t *dst, const ARGB32_t *src, size_t n) {
+    if (!dst || !src) return;
+    premul_span(dst, src, n, 0);
+}
+
+static void __p_R_e_M_u_L_s_P_a_N_r_G_b_A_3_2__(RGBA32_t *dst, const RGBA32_t *src, size_t n) {
+    if (!dst || !src) return;
+    premul_span(dst, src, n, 1);
+}
+
+static void __u_N_p_R_e_M_u_L_s_P_a_N_a_R_g_B_3_2__(ARGB32_t *dst, const ARGB32_t *src, size_t n) {
+    if (!dst || !src) return;
+    for (size_t i = 0; i < n; i++) dst[i] = unpremul_1(src[i], 0);
+}
+
+static void __u_N_p_R_e_M_u_L_s_P_a_N_r_G_b_A_3_2__(RGBA32_t *dst, const RGBA32_t *src, size_t n) {
+    if (!dst || !src) return;
+    for (size_t i = 0; i < n; i++) dst[i] = unpremul_1(src[i], 1);
+}
+
+static void __c_O_m_P_o_S_i_T_e_S_p_A_n_A_r_G_b_3_2__(porterduff_op_t op, ARGB32_t *dst, const ARGB32_t *src, size_t n) {
+    if (!dst || !src) return;
+    STAT_SCOPE_BEGIN(scope);
+    composite_span(op, dst, src, n, 0);
+    STAT_SCOPE_END(scope, STAT_COMPOSITE_SPAN, n * sizeof(ARGB32_t));
+}
+
+static void __c_O_m_P_o_S_i_T_e_S_p_A_n_R_g_B_a_3_2__(porterduff_op_t op, RGBA32_t *dst, const RGBA32_t *src, size_t n) {
+    if (!dst || !src) return;
+    STAT_SCOPE_BEGIN(scope);
+    composite_span(op, dst, src, n, 1);
+    STAT_SCOPE_END(scope, STAT_COMPOSITE_SPAN, n * sizeof(RGBA32_t));
+}
+
+
+__attribute__((weak, alias("__p_R_e_M_u_L_a_R_g_B_3_2__"))) ARGB32_t premulARGB32(ARGB32_t argb);
+__attribute__((weak, alias("__p_R_e_M_u_L_r_G_b_A_3_2__"))) RGBA32_t premulRGBA32(RGBA32_t rgba);
+__attribute__((weak, alias("__u_N_p_R_e_M_u_L_a_R_g_B_3_2__"))) ARGB32_t unpremulARGB32(ARGB32_t argb);
+__attribute__((weak, alias("__u_N_p_R_e_M_u_L_r_G_b_A_3_2__"))) RGBA32_t unpremulRGBA32(RGBA32_t rgba);
+__attribute__((weak, alias("__p_R_e_M_u_L_s_P_a_N_a_R_g_B_3_2__"))) void premulSpanARGB32(ARGB32_t *dst, const ARGB32_t *src, size_t n);
+__attribute__((weak, alias("__p_R_e_M_u_L_s_P_a_N_r_G_b_A_3_2__"))) void premulSpanRGBA32(RGBA32_t *dst, const RGBA32_t *src, size_t n);
+__attribute__((weak, alias("__u_N_p_R_e_M_u_L_s_P_a_N_a_R_g_B_3_2__"))) void unpremulSpanARGB32(ARGB32_t *dst, const ARGB32_t *src, size_t n);
+__attribute__((weak, alias("__u_N_p_R_e_M_u_L_s_P_a_N_r_G_b_A_3_2__"))) void unpremulSpanRGBA32(RGBA32_t *dst, const RGBA32_t *src, size_t n);
+__attribute__((weak, alias("__c_O_m_P_o_S_i_T_e_S_p_A_n_A_r_G_b_3_2__")))
+void compositeSpanARGB32(porterduff_op_t op, ARGB32_t *dst, const ARGB32_t *src, size_t n);
+__attribute__((weak, alias("__c_O_m_P_o_S_i_T_e_S_p_A_n_R_g_B_a_3_2__")))
+void compositeSpanRGBA32(porterduff_op_t op, RGBA32_t *dst, const RGBA32_t *src, size_t n);
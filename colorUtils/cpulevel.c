@@ -0,0 +1,62 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "colorutl.h"
+
+// Runtime SIMD level used by the dispatching batch routines (colorUtils) and
+// hex-table kernels (printHexTable). Detected once; RADIO_UTILS_CPU=scalar|sse2|avx2
+// forces a lower level for testing and benchmarking (never one the CPU lacks).
+
+static int cpu_level_cached = -1;
+
+static cpu_level_t cpu_level_detect(void) {
+#if COLORUTL_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return CPU_LEVEL_AVX2;
+#if defined(__SSE2__)
+    if (__builtin_cpu_supports("sse2")) return CPU_LEVEL_SSE2;
+#endif
+#endif
+    return CPU_LEVEL_SCALAR;
+}
+
+static int cpu_level_parse(const char *s) {
+    static const char *NAMES[] = { "scalar", "sse2", "avx2" };
+    if (!s) return -1;
+    for (int lvl = 0; lvl < 3; lvl++) {
+        const char *a = s, *b = NAMES[lvl];
+        while (*a && *b && (*a | 0x20) == *b) { a++; b++; }
+        if (*a == '\0' && *b == '\0') return lvl;
+    }
+    return -1;
+}
+
+static const char *__c_P_u_L_e_V_e_L_n_A_m_E__(cpu_level_t level) {
+    switch (level) {
+    case CPU_LEVEL_SCALAR: return "scalar";
+    case CPU_LEVEL_SSE2:   return "sse2";
+    case CPU_LEVEL_AVX2:   return "avx2";
+    }
+    return "unknown";
+}
+
+static cpu_level_t __c_P_u_L_e_V_e_L_s_U_p_P_o_R_t_E_d__(void) {
+    return cpu_level_detect();
+}
+
+static cpu_level_t __c_P_u_L_e_V_e_L__(void) {
+    int lvl = __atomic_load_n(&cpu_level_cached, __ATOMIC_RELAXED);
+    if (lvl < 0) {
+        lvl = cpu_level_detect();
+        int forced = cpu_level_parse(getenv("RADIO_UTILS_CPU"));
+        if (forced >= 0 && forced < lvl) lvl = forced;
+        __atomic_store_n(&cpu_level_cached, lvl, __ATOMIC_RELAXED);
+    }
+    return (cpu_level_t)lvl;
+}
+
+
+__attribute__((weak, alias("__c_P_u_L_e_V_e_L__"))) cpu_level_t cpuLevel(void);
+__attribute__((weak, alias("__c_P_u_L_e_V_e_L_s_U_p_P_o_R_t_E_d__"))) cpu_level_t cpuLevelSupported(void);
+__attribute__((weak, alias("__c_P_u_L_e_V_e_L_n_A_m_E__"))) const char *cpuLevelName(cpu_level_t level);
@@ -0,0 +1,49 @@
+#ifndef COLORUTL_CPULEVEL_H
+#define COLORUTL_CPULEVEL_H
+
+// Internal: shared by the colorUtils and printHexTable sources that pick SIMD
+// kernels at run time, so every module resolves and overrides the same way.
+
+#include "colorutl.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if COLORUTL_X86_DISPATCH
+#include <immintrin.h>
+
+// AVX2 helpers carry a target attribute; the build flags stay at the baseline.
+#define AVX2_FN static inline __attribute__((target("avx2")))
+#endif
+
+#if defined(__SSE2__)
+#define CPU_LEVEL_SSE2_ONLY(...) __VA_ARGS__
+#else
+#define CPU_LEVEL_SSE2_ONLY(...)
+#endif
+#if COLORUTL_X86_DISPATCH
+#define CPU_LEVEL_AVX2_ONLY(...) __VA_ARGS__
+#else
+#define CPU_LEVEL_AVX2_ONLY(...)
+#endif
+
+// Evaluates to avx2 at CPU_LEVEL_AVX2, sse2 at CPU_LEVEL_SSE2 and above,
+// scalar otherwise; a level this build does not compile falls back to the
+// next one down, and its argument is dropped unevaluated. type may be a
+// table pointer or a function pointer (NULL is a valid choice). The pick is
+// made once per call site, so wrap it in a small resolver function.
+#define CPU_LEVEL_DISPATCH(type, scalar, sse2, avx2) __extension__({                           \
+        static type cpu_level_impl_;                                                           \
+        static int cpu_level_resolved_;                                                        \
+        if (!__atomic_load_n(&cpu_level_resolved_, __ATOMIC_ACQUIRE)) {                        \
+            type cpu_level_p_ = (scalar);                                                      \
+            __attribute__((unused)) cpu_level_t cpu_level_l_ = cpuLevel();                     \
+            CPU_LEVEL_SSE2_ONLY(if (cpu_level_l_ >= CPU_LEVEL_SSE2) cpu_level_p_ = (sse2);)    \
+            CPU_LEVEL_AVX2_ONLY(if (cpu_level_l_ >= CPU_LEVEL_AVX2) cpu_level_p_ = (avx2);)    \
+            __atomic_store_n(&cpu_level_impl_, cpu_level_p_, __ATOMIC_RELAXED);                \
+            __atomic_store_n(&cpu_level_resolved_, 1, __ATOMIC_RELEASE);                       \
+        }                                                                                      \
+        __atomic_load_n(&cpu_level_impl_, __ATOMIC_RELAXED);                                   \
+    })
+
+#endif
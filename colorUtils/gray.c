@@ -4,22 +4,17 @@
 #include <math.h>
 #include "colorutl.h"
 
+// Bodies live in colorutl_inline.h (standard grayscale formula).
 static uint8_t __r_g_b_5_6_5_2_g_r_a_y__(uint16_t rgb565) {
-    // Extract components
-    uint8_t r = ((rgb565 >> 11) & 0x1F) << 3;  // 5-bit to 8-bit
-    uint8_t g = ((rgb565 >> 5) & 0x3F) << 2;   // 6-bit to 8-bit
-    uint8_t b = (rgb565 & 0x1F) << 3;          // 5-bit to 8-bit
-
-    // Standard grayscale formula
-    return (uint8_t)((r * 0.299f) + (g * 0.587f) + (b * 0.114f) + 0.5f);
+    return rgb565_2gray_inline(rgb565);
 }
 
 static uint8_t __r_g_b_8_8_8_2_g_r_a_y__(uint8_t r, uint8_t g, uint8_t b) {
-    return (uint8_t)((r * 0.299f) + (g * 0.587f) + (b * 0.114f) + 0.5f);
+    return rgb888_2gray_inline(r, g, b);
 }
 
 static uint8_t __g_r_a_y_2_1_b_i_t__(uint8_t gray) {
-    return gray >= 128 ? 1 : 0;
+    return gray2_1bit_inline(gray);
 }
 
 __attribute__((weak, alias("__r_g_b_5_6_5_2_g_r_a_y__"))) uint8_t rgb565_2gray(uint16_t rgb565);
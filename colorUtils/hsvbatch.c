@@ -0,0 +1,403 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "colorutl.h"
+#include <statUtils/statutl.h>
+#include "cpulevel.h"
+
+// Batch (structure-of-arrays) variants of hsv2rgb / rgb2hsv / hsl2rgb / rgb2hsl.
+//
+// The kernels are branch-free rewrites of the scalar functions:
+//   hsv -> rgb : f(n) = v - c * max(0, min(k, 4 - k, 1)),   k = (n + h / 60) mod 6
+//   hsl -> rgb : f(n) = l - a * max(-1, min(k - 3, 9 - k, 1)), k = (n + h / 30) mod 12
+// and select the rgb -> hue sector with masks instead of if/else chains.
+// Results match the scalar functions within float rounding for h >= 0;
+// negative hues are wrapped into [0, 360) instead of being passed through.
+// Any finite hue is wrapped (float has no fraction left past 2^23 degrees,
+// so huge hues only promise an in-range colour), and NaN or infinite hue is
+// read as 0 on every level.
+//
+// Scalar, SSE2 (4 lanes) and AVX2 (8 lanes) drivers live side by side; the
+// exported functions call through a table picked once from cpuLevel().
+
+static inline float wrap_f(float x, float period) {
+    return x - period * floorf(x / period);
+}
+
+static inline void hsv2rgb_1(float h, float s, float v, float *r, float *g, float *b) {
+    h = isfinite(h) ? h : 0.0f;
+    s = CLAMP01(s);
+    v = CLAMP01(v);
+    float hh = wrap_f(h / 60.0f, 6.0f);
+    float c = v * s;
+    float kr = wrap_f(5.0f + hh, 6.0f);
+    float kg = wrap_f(3.0f + hh, 6.0f);
+    float kb = wrap_f(1.0f + hh, 6.0f);
+    *r = v - c * fmaxf(0.0f, fminf(fminf(kr, 4.0f - kr), 1.0f));
+    *g = v - c * fmaxf(0.0f, fminf(fminf(kg, 4.0f - kg), 1.0f));
+    *b = v - c * fmaxf(0.0f, fminf(fminf(kb, 4.0f - kb), 1.0f));
+}
+
+static inline void hsl2rgb_1(float h, float s, float l, float *r, float *g, float *b) {
+    h = isfinite(h) ? h : 0.0f;
+    s = CLAMP01(s);
+    l = CLAMP01(l);
+    float hh = wrap_f(h / 30.0f, 12.0f);
+    float a = s * fminf(l, 1.0f - l);
+    float kr = wrap_f(0.0f + hh, 12.0f);
+    float kg = wrap_f(8.0f + hh, 12.0f);
+    float kb = wrap_f(4.0f + hh, 12.0f);
+    *r = l - a * fmaxf(-1.0f, fminf(fminf(kr - 3.0f, 9.0f - kr), 1.0f));
+    *g = l - a * fmaxf(-1.0f, fminf(fminf(kg - 3.0f, 9.0f - kg), 1.0f));
+    *b = l - a * fmaxf(-1.0f, fminf(fminf(kb - 3.0f, 9.0f - kb), 1.0f));
+}
+
+// Hue in degrees from max/delta, sector chosen in the same order as rgb2hsv (r, g, b).
+static inline float rgb_hue_1(float r, float g, float b, float max, float delta) {
+    float num = (max == r) ? (g - b) : ((max == g) ? (b - r) : (r - g));
+    float off = (max == r) ? 0.0f : ((max == g) ? 2.0f : 4.0f);
+    float h = 60.0f * (num / (delta == 0 ? 1.0f : delta) + off);
+    h = (h < 0) ? h + 360.0f : h;
+    return (delta == 0) ? 0.0f : h;
+}
+
+static inline void rgb2hsv_1(float r, float g, float b, float *h, float *s, float *v) {
+    float max = fmaxf(r, fmaxf(g, b));
+    float min = fminf(r, fminf(g, b));
+    float delta = max - min;
+
+    *h = rgb_hue_1(r, g, b, max, delta);
+    *s = (max == 0) ? 0.0f : delta / max;
+    *v = max;
+}
+
+static inline void rgb2hsl_1(float r, float g, float b, float *h, float *s, float *l) {
+    float max = fmaxf(r, fmaxf(g, b));
+    float min = fminf(r, fminf(g, b));
+    float delta = max - min;
+    float lum = (max + min) / 2;
+    float den = 1 - fabsf(2 * lum - 1);
+
+    *h = rgb_hue_1(r, g, b, max, delta);
+    *s = (delta == 0) ? 0.0f : delta / den;
+    *l = lum;
+}
+
+#if defined(__SSE2__)
+
+// From |x| >= 2^23 on every float is an integer, and cvttps would overflow
+// past 2^31, so those lanes are their own floor.
+static inline __m128 floor_sse2(__m128 x) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.0f)));
+    __m128 big = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), x), _mm_set1_ps(8388608.0f));
+    return _mm_or_ps(_mm_and_ps(big, x), _mm_andnot_ps(big, t));
+}
+
+// NaN and +-Inf to 0, like isfinite() in the scalar path.
+static inline __m128 finite_sse2(__m128 x) {
+    return _mm_and_ps(x, _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), x), _mm_set1_ps(INFINITY)));
+}
+
+static inline __m128 wrap_sse2(__m128 x, __m128 period, __m128 inv_period) {
+    return _mm_sub_ps(x, _mm_mul_ps(period, floor_sse2(_mm_mul_ps(x, inv_period))));
+}
+
+static inline __m128 clamp01_sse2(__m128 x) {
+    return _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+static inline __m128 select_sse2(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 hsv_chan_sse2(__m128 n, __m128 hh, __m128 v, __m128 c) {
+    const __m128 six = _mm_set1_ps(6.0f);
+    __m128 k = _mm_add_ps(n, hh);
+    k = _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, six), six));
+    __m128 t = _mm_min_ps(_mm_min_ps(k, _mm_sub_ps(_mm_set1_ps(4.0f), k)), _mm_set1_ps(1.0f));
+    return _mm_sub_ps(v, _mm_mul_ps(c, _mm_max_ps(t, _mm_setzero_ps())));
+}
+
+static inline void hsv2rgb_sse2(const float *h, const float *s, const float *v,
+                                float *r, float *g, float *b) {
+    __m128 vs = clamp01_sse2(_mm_loadu_ps(s));
+    __m128 vv = clamp01_sse2(_mm_loadu_ps(v));
+    __m128 hh = _mm_mul_ps(finite_sse2(_mm_loadu_ps(h)), _mm_set1_ps(1.0f / 60.0f));
+    hh = wrap_sse2(hh, _mm_set1_ps(6.0f), _mm_set1_ps(1.0f / 6.0f));
+    __m128 c = _mm_mul_ps(vv, vs);
+
+    _mm_storeu_ps(r, hsv_chan_sse2(_mm_set1_ps(5.0f), hh, vv, c));
+    _mm_storeu_ps(g, hsv_chan_sse2(_mm_set1_ps(3.0f), hh, vv, c));
+    _mm_storeu_ps(b, hsv_chan_sse2(_mm_set1_ps(1.0f), hh, vv, c));
+}
+
+static inline __m128 hsl_chan_sse2(__m128 n, __m128 hh, __m128 l, __m128 a) {
+    const __m128 twelve = _mm_set1_ps(12.0f);
+    __m128 k = _mm_add_ps(n, hh);
+    k = _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, twelve), twelve));
+    __m128 t = _mm_min_ps(_mm_min_ps(_mm_sub_ps(k, _mm_set1_ps(3.0f)),
+                                     _mm_sub_ps(_mm_set1_ps(9.0f), k)),
+                          _mm_set1_ps(1.0f));
+    return _mm_sub_ps(l, _mm_mul_ps(a, _mm_max_ps(t, _mm_set1_ps(-1.0f))));
+}
+
+static inline void hsl2rgb_sse2(const float *h, const float *s, const float *l,
+                                float *r, float *g, float *b) {
+    __m128 vs = clamp01_sse2(_mm_loadu_ps(s));
+    __m128 vl = clamp01_sse2(_mm_loadu_ps(l));
+    __m128 hh = _mm_mul_ps(finite_sse2(_mm_loadu_ps(h)), _mm_set1_ps(1.0f / 30.0f));
+    hh = wrap_sse2(hh, _mm_set1_ps(12.0f), _mm_set1_ps(1.0f / 12.0f));
+    __m128 a = _mm_mul_ps(vs, _mm_min_ps(vl, _mm_sub_ps(_mm_set1_ps(1.0f), vl)));
+
+    _mm_storeu_ps(r, hsl_chan_sse2(_mm_set1_ps(0.0f), hh, vl, a));
+    _mm_storeu_ps(g, hsl_chan_sse2(_mm_set1_ps(8.0f), hh, vl, a));
+    _mm_storeu_ps(b, hsl_chan_sse2(_mm_set1_ps(4.0f), hh, vl, a));
+}
+
+static inline __m128 rgb_hue_sse2(__m128 r, __m128 g, __m128 b, __m128 max, __m128 delta) {
+    __m128 zero = _mm_setzero_ps();
+    __m128 dz = _mm_cmpeq_ps(delta, zero);
+    __m128 mr = _mm_cmpeq_ps(max, r);
+    __m128 mg = _mm_cmpeq_ps(max, g);
+    __m128 num = select_sse2(mr, _mm_sub_ps(g, b),
+                             select_sse2(mg, _mm_sub_ps(b, r), _mm_sub_ps(r, g)));
+    __m128 off = select_sse2(mr, zero,
+                             select_sse2(mg, _mm_set1_ps(2.0f), _mm_set1_ps(4.0f)));
+    __m128 q = _mm_div_ps(num, select_sse2(dz, _mm_set1_ps(1.0f), delta));
+    __m128 h = _mm_mul_ps(_mm_set1_ps(60.0f), _mm_add_ps(q, off));
+    h = _mm_add_ps(h, _mm_and_ps(_mm_cmplt_ps(h, zero), _mm_set1_ps(360.0f)));
+    return _mm_andnot_ps(dz, h);
+}
+
+static inline void rgb2hsv_sse2(const float *r, const float *g, const float *b,
+                                float *h, float *s, float *v) {
+    __m128 vr = _mm_loadu_ps(r), vg = _mm_loadu_ps(g), vb = _mm_loadu_ps(b);
+    __m128 max = _mm_max_ps(vr, _mm_max_ps(vg, vb));
+    __m128 min = _mm_min_ps(vr, _mm_min_ps(vg, vb));
+    __m128 delta = _mm_sub_ps(max, min);
+    __m128 mz = _mm_cmpeq_ps(max, _mm_setzero_ps());
+
+    _mm_storeu_ps(h, rgb_hue_sse2(vr, vg, vb, max, delta));
+    _mm_storeu_ps(s, _mm_andnot_ps(mz, _mm_div_ps(delta, select_sse2(mz, _mm_set1_ps(1.0f), max))));
+    _mm_storeu_ps(v, max);
+}
+
+static inline void rgb2hsl_sse2(const float *r, const float *g, const float *b,
+                                float *h, float *s, float *l) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 vr = _mm_loadu_ps(r), vg = _mm_loadu_ps(g), vb = _mm_loadu_ps(b);
+    __m128 max = _mm_max_ps(vr, _mm_max_ps(vg, vb));
+    __m128 min = _mm_min_ps(vr, _mm_min_ps(vg, vb));
+    __m128 delta = _mm_sub_ps(max, min);
+    __m128 dz = _mm_cmpeq_ps(delta, _mm_setzero_ps());
+    __m128 lum = _mm_mul_ps(_mm_add_ps(max, min), _mm_set1_ps(0.5f));
+    __m128 den = _mm_sub_ps(one, _mm_andnot_ps(sign, _mm_sub_ps(_mm_add_ps(lum, lum), one)));
+
+    _mm_storeu_ps(h, rgb_hue_sse2(vr, vg, vb, max, delta));
+    _mm_storeu_ps(s, _mm_andnot_ps(dz, _mm_div_ps(delta, select_sse2(dz, one, den))));
+    _mm_storeu_ps(l, lum);
+}
+
+#endif // __SSE2__
+
+#if COLORUTL_X86_DISPATCH
+
+AVX2_FN __m256 wrap_avx2(__m256 x, __m256 period, __m256 inv_period) {
+    return _mm256_sub_ps(x, _mm256_mul_ps(period, _mm256_floor_ps(_mm256_mul_ps(x, inv_period))));
+}
+
+AVX2_FN __m256 finite_avx2(__m256 x) {
+    return _mm256_and_ps(x, _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), x), _mm256_set1_ps(INFINITY),
+                                          _CMP_LT_OQ));
+}
+
+AVX2_FN __m256 clamp01_avx2(__m256 x) {
+    return _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+
+AVX2_FN __m256 hsv_chan_avx2(__m256 n, __m256 hh, __m256 v, __m256 c) {
+    const __m256 six = _mm256_set1_ps(6.0f);
+    __m256 k = _mm256_add_ps(n, hh);
+    k = _mm256_sub_ps(k, _mm256_and_ps(_mm256_cmp_ps(k, six, _CMP_GE_OQ), six));
+    __m256 t = _mm256_min_ps(_mm256_min_ps(k, _mm256_sub_ps(_mm256_set1_ps(4.0f), k)), _mm256_set1_ps(1.0f));
+    return _mm256_sub_ps(v, _mm256_mul_ps(c, _mm256_max_ps(t, _mm256_setzero_ps())));
+}
+
+AVX2_FN void hsv2rgb_avx2(const float *h, const float *s, const float *v,
+                          float *r, float *g, float *b) {
+    __m256 vs = clamp01_avx2(_mm256_loadu_ps(s));
+    __m256 vv = clamp01_avx2(_mm256_loadu_ps(v));
+    __m256 hh = _mm256_mul_ps(finite_avx2(_mm256_loadu_ps(h)), _mm256_set1_ps(1.0f / 60.0f));
+    hh = wrap_avx2(hh, _mm256_set1_ps(6.0f), _mm256_set1_ps(1.0f / 6.0f));
+    __m256 c = _mm256_mul_ps(vv, vs);
+
+    _mm256_storeu_ps(r, hsv_chan_avx2(_mm256_set1_ps(5.0f), hh, vv, c));
+    _mm256_storeu_ps(g, hsv_chan_avx2(_mm256_set1_ps(3.0f), hh, vv, c));
+    _mm256_storeu_ps(b, hsv_chan_avx2(_mm256_set1_ps(1.0f), hh, vv, c));
+}
+
+AVX2_FN __m256 hsl_chan_avx2(__m256 n, __m256 hh, __m256 l, __m256 a) {
+    const __m256 twelve = _mm256_set1_ps(12.0f);
+    __m256 k = _mm256_add_ps(n, hh);
+    k = _mm256_sub_ps(k, _mm256_and_ps(_mm256_cmp_ps(k, twelve, _CMP_GE_OQ), twelve));
+    __m256 t = _mm256_min_ps(_mm256_min_ps(_mm256_sub_ps(k, _mm256_set1_ps(3.0f)),
+                                           _mm256_sub_ps(_mm256_set1_ps(9.0f), k)),
+                             _mm256_set1_ps(1.0f));
+    return _mm256_sub_ps(l, _mm256_mul_ps(a, _mm256_max_ps(t, _mm256_set1_ps(-1.0f))));
+}
+
+AVX2_FN void hsl2rgb_avx2(const float *h, const float *s, const float *l,
+                          float *r, float *g, float *b) {
+    __m256 vs = clamp01_avx2(_mm256_loadu_ps(s));
+    __m256 vl = clamp01_avx2(_mm256_loadu_ps(l));
+    __m256 hh = _mm256_mul_ps(finite_avx2(_mm256_loadu_ps(h)), _mm256_set1_ps(1.0f / 30.0f));
+    hh = wrap_avx2(hh, _mm256_set1_ps(12.0f), _mm256_set1_ps(1.0f / 12.0f));
+    __m256 a = _mm256_mul_ps(vs, _mm256_min_ps(vl, _mm256_sub_ps(_mm256_set1_ps(1.0f), vl)));
+
+    _mm256_storeu_ps(r, hsl_chan_avx2(_mm256_set1_ps(0.0f), hh, vl, a));
+    _mm256_storeu_ps(g, hsl_chan_avx2(_mm256_set1_ps(8.0f), hh, vl, a));
+    _mm256_storeu_ps(b, hsl_chan_avx2(_mm256_set1_ps(4.0f), hh, vl, a));
+}
+
+AVX2_FN __m256 rgb_hue_avx2(__m256 r, __m256 g, __m256 b, __m256 max, __m256 delta) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 dz = _mm256_cmp_ps(delta, zero, _CMP_EQ_OQ);
+    __m256 mr = _mm256_cmp_ps(max, r, _CMP_EQ_OQ);
+    __m256 mg = _mm256_cmp_ps(max, g, _CMP_EQ_OQ);
+    __m256 num = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_sub_ps(r, g), _mm256_sub_ps(b, r), mg),
+                                  _mm256_sub_ps(g, b), mr);
+    __m256 off = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_set1_ps(4.0f), _mm256_set1_ps(2.0f), mg),
+                                  zero, mr);
+    __m256 q = _mm256_div_ps(num, _mm256_blendv_ps(delta, _mm256_set1_ps(1.0f), dz));
+    __m256 h = _mm256_mul_ps(_mm256_set1_ps(60.0f), _mm256_add_ps(q, off));
+    h = _mm256_add_ps(h, _mm256_and_ps(_mm256_cmp_ps(h, zero, _CMP_LT_OQ), _mm256_set1_ps(360.0f)));
+    return _mm256_andnot_ps(dz, h);
+}
+
+AVX2_FN void rgb2hsv_avx2(const float *r, const float *g, const float *b,
+                          float *h, float *s, float *v) {
+    __m256 vr = _mm256_loadu_ps(r), vg = _mm256_loadu_ps(g), vb = _mm256_loadu_ps(b);
+    __m256 max = _mm256_max_ps(vr, _mm256_max_ps(vg, vb));
+    __m256 min = _mm256_min_ps(vr, _mm256_min_ps(vg, vb));
+    __m256 delta = _mm256_sub_ps(max, min);
+    __m256 mz = _mm256_cmp_ps(max, _mm256_setzero_ps(), _CMP_EQ_OQ);
+
+    _mm256_storeu_ps(h, rgb_hue_avx2(vr, vg, vb, max, delta));
+    _mm256_storeu_ps(s, _mm256_andnot_ps(mz, _mm256_div_ps(delta, _mm256_blendv_ps(max, _mm256_set1_ps(1.0f), mz))));
+    _mm256_storeu_ps(v, max);
+}
+
+AVX2_FN void rgb2hsl_avx2(const float *r, const float *g, const float *b,
+                          float *h, float *s, float *l) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 vr = _mm256_loadu_ps(r), vg = _mm256_loadu_ps(g), vb = _mm256_loadu_ps(b);
+    __m256 max = _mm256_max_ps(vr, _mm256_max_ps(vg, vb));
+    __m256 min = _mm256_min_ps(vr, _mm256_min_ps(vg, vb));
+    __m256 delta = _mm256_sub_ps(max, min);
+    __m256 dz = _mm256_cmp_ps(delta, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    __m256 lum = _mm256_mul_ps(_mm256_add_ps(max, min), _mm256_set1_ps(0.5f));
+    __m256 den = _mm256_sub_ps(one, _mm256_andnot_ps(sign, _mm256_sub_ps(_mm256_add_ps(lum, lum), one)));
+
+    _mm256_storeu_ps(h, rgb_hue_avx2(vr, vg, vb, max, delta));
+    _mm256_storeu_ps(s, _mm256_andnot_ps(dz, _mm256_div_ps(delta, _mm256_blendv_ps(den, one, dz))));
+    _mm256_storeu_ps(l, lum);
+}
+
+#endif // COLORUTL_X86_DISPATCH
+
+
+// Per-level drivers: vector body, scalar tail.
+typedef void (*hsvbatch_fn)(const float *, const float *, const float *, float *, float *, float *, size_t);
+
+typedef struct {
+    hsvbatch_fn hsv2rgb;
+    hsvbatch_fn hsl2rgb;
+    hsvbatch_fn rgb2hsv;
+    hsvbatch_fn rgb2hsl;
+} hsvbatch_impl_t;
+
+#define HSVBATCH_DRIVER(name, attr, kernel, width, one)                                   \
+    attr void name(const float *x, const float *y, const float *z,                        \
+                   float *a, float *b, float *c, size_t n) {                              \
+        size_t i = 0;                                                                     \
+        for (; i + (width) <= n; i += (width))                                            \
+            kernel(x + i, y + i, z + i, a + i, b + i, c + i);                             \
+        for (; i < n; i++) one(x[i], y[i], z[i], &a[i], &b[i], &c[i]);                    \
+    }
+
+#define HSVBATCH_SCALAR_DRIVER(name, one)                                                 \
+    static void name(const float *x, const float *y, const float *z,                      \
+                     float *a, float *b, float *c, size_t n) {                            \
+        for (size_t i = 0; i < n; i++) one(x[i], y[i], z[i], &a[i], &b[i], &c[i]);        \
+    }
+
+HSVBATCH_SCALAR_DRIVER(hsv2rgb_scalar, hsv2rgb_1)
+HSVBATCH_SCALAR_DRIVER(hsl2rgb_scalar, hsl2rgb_1)
+HSVBATCH_SCALAR_DRIVER(rgb2hsv_scalar, rgb2hsv_1)
+HSVBATCH_SCALAR_DRIVER(rgb2hsl_scalar, rgb2hsl_1)
+
+static const hsvbatch_impl_t HSVBATCH_SCALAR = { hsv2rgb_scalar, hsl2rgb_scalar, rgb2hsv_scalar, rgb2hsl_scalar };
+
+#if defined(__SSE2__)
+HSVBATCH_DRIVER(hsv2rgb_sse2_n, static, hsv2rgb_sse2, 4, hsv2rgb_1)
+HSVBATCH_DRIVER(hsl2rgb_sse2_n, static, hsl2rgb_sse2, 4, hsl2rgb_1)
+HSVBATCH_DRIVER(rgb2hsv_sse2_n, static, rgb2hsv_sse2, 4, rgb2hsv_1)
+HSVBATCH_DRIVER(rgb2hsl_sse2_n, static, rgb2hsl_sse2, 4, rgb2hsl_1)
+
+static const hsvbatch_impl_t HSVBATCH_SSE2 = { hsv2rgb_sse2_n, hsl2rgb_sse2_n, rgb2hsv_sse2_n, rgb2hsl_sse2_n };
+#endif
+
+#if COLORUTL_X86_DISPATCH
+HSVBATCH_DRIVER(hsv2rgb_avx2_n, static __attribute__((target("avx2"))), hsv2rgb_avx2, 8, hsv2rgb_1)
+HSVBATCH_DRIVER(hsl2rgb_avx2_n, static __attribute__((target("avx2"))), hsl2rgb_avx2, 8, hsl2rgb_1)
+HSVBATCH_DRIVER(rgb2hsv_avx2_n, static __attribute__((target("avx2"))), rgb2hsv_avx2, 8, rgb2hsv_1)
+HSVBATCH_DRIVER(rgb2hsl_avx2_n, static __attribute__((target("avx2"))), rgb2hsl_avx2, 8, rgb2hsl_1)
+
+static const hsvbatch_impl_t HSVBATCH_AVX2 = { hsv2rgb_avx2_n, hsl2rgb_avx2_n, rgb2hsv_avx2_n, rgb2hsl_avx2_n };
+#endif
+
+static const hsvbatch_impl_t *hsvbatch_impl(void) {
+    return CPU_LEVEL_DISPATCH(const hsvbatch_impl_t *, &HSVBATCH_SCALAR, &HSVBATCH_SSE2, &HSVBATCH_AVX2);
+}
+
+
+static void __h_S_v_2_r_G_b_B_a_T_c_H__(const float *h, const float *s, const float *v,
+                                        float *r, float *g, float *b, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    hsvbatch_impl()->hsv2rgb(h, s, v, r, g, b, n);
+    STAT_SCOPE_END(scope, STAT_HSV2RGB_BATCH, n * 3 * sizeof(float));
+}
+
+static void __h_S_l_2_r_G_b_B_a_T_c_H__(const float *h, const float *s, const float *l,
+                                        float *r, float *g, float *b, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    hsvbatch_impl()->hsl2rgb(h, s, l, r, g, b, n);
+    STAT_SCOPE_END(scope, STAT_HSL2RGB_BATCH, n * 3 * sizeof(float));
+}
+
+static void __r_G_b_2_h_S_v_B_a_T_c_H__(const float *r, const float *g, const float *b,
+                                        float *h, float *s, float *v, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    hsvbatch_impl()->rgb2hsv(r, g, b, h, s, v, n);
+    STAT_SCOPE_END(scope, STAT_RGB2HSV_BATCH, n * 3 * sizeof(float));
+}
+
+static void __r_G_b_2_h_S_l_B_a_T_c_H__(const float *r, const float *g, const float *b,
+                                        float *h, float *s, float *l, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    hsvbatch_impl()->rgb2hsl(r, g, b, h, s, l, n);
+    STAT_SCOPE_END(scope, STAT_RGB2HSL_BATCH, n * 3 * sizeof(float));
+}
+
+__attribute__((weak, alias("__h_S_v_2_r_G_b_B_a_T_c_H__")))
+void hsv2rgb_batch(const float *h, const float *s, const float *v, float *r, float *g, float *b, size_t n);
+__attribute__((weak, alias("__h_S_l_2_r_G_b_B_a_T_c_H__")))
+void hsl2rgb_batch(const float *h, const float *s, const float *l, float *r, float *g, float *b, size_t n);
+__attribute__((weak, alias("__r_G_b_2_h_S_v_B_a_T_c_H__")))
+void rgb2hsv_batch(const float *r, const float *g, const float *b, float *h, float *s, float *v, size_t n);
+__attribute__((weak, alias("__r_G_b_2_h_S_l_B_a_T_c_H__")))
+void rgb2hsl_batch(const float *r, const float *g, const float *b, float *h, float *s, float *l, size_t n);
@@ -0,0 +1,275 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "colorutl.h"
+#include <statUtils/statutl.h>
+
+// Fixed-point HSV / HSL for targets without an FPU (Cortex-M0, AVR).
+//
+// Hue is a fraction of a turn: 8-bit 256 = 360 deg, 16-bit 65536 = 360 deg,
+// so wrapping is free. Saturation, value and lightness are full scale at
+// 255 / 65535. Both paths use the same piecewise form as hsv2rgb/hsl2rgb:
+// each 60 deg sector has one channel at hi, one at lo and one ramping
+//   up   = lo + (hi - lo) * f     or     down = hi - (hi - lo) * f
+// with f the position inside the sector. The 8-bit path only needs 8x8
+// multiplies and unsigned 16-bit sums (HSL adds in 32 bits), so it is safe
+// with 16-bit int; the 16-bit path needs 16x16 -> 32 multiplies. Neither
+// divides; rgb -> hsv/hsl needs one integer division per component.
+// Results stay within one LSB of the float functions rounded to nearest
+// (see test/hsvfix_Test.c).
+
+// x / 255 rounded, exact for x <= 65407 (x + 128 must fit in 16 bits);
+// every caller passes at most 255 * 255.
+static inline uint16_t div255(uint16_t x) {
+    x += 128;
+    return (uint16_t)((x + (x >> 8)) >> 8);
+}
+
+// a * b / 65535 rounded, exact for a, b <= 65535.
+static inline uint32_t mul16(uint32_t a, uint32_t b) {
+    uint32_t x = a * b + 32768u;
+    return (x + (x >> 16)) >> 16;
+}
+
+static inline uint16_t pack565_8(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint16_t)((div255((uint16_t)(r * 31)) << 11) | (div255((uint16_t)(g * 63)) << 5) | div255((uint16_t)(b * 31)));
+}
+
+static inline uint8_t to8_16(uint32_t x) {
+    return (uint8_t)((x * 255u + 32768u) >> 16);
+}
+
+static inline uint16_t pack565_16(uint32_t r, uint32_t g, uint32_t b) {
+    return (uint16_t)((((r * 31u + 32768u) >> 16) << 11) | (((g * 63u + 32768u) >> 16) << 5) | ((b * 31u + 32768u) >> 16));
+}
+
+// Places hi / lo / the ramp into r, g, b for one sector (same order as hsv2rgb).
+#define HUE_SECTOR(sector, hi, lo, up, down, r, g, b) do {      \
+    switch (sector) {                                           \
+        case 0:  r = hi;   g = up;   b = lo;   break;           \
+        case 1:  r = down; g = hi;   b = lo;   break;           \
+        case 2:  r = lo;   g = hi;   b = up;   break;           \
+        case 3:  r = lo;   g = down; b = hi;   break;           \
+        case 4:  r = up;   g = lo;   b = hi;   break;           \
+        default: r = hi;   g = lo;   b = down; break;           \
+    }                                                           \
+} while (0)
+
+static inline void hsv8_1(uint8_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b) {
+    uint16_t pos = (uint16_t)(h * 6);
+    uint8_t f = (uint8_t)pos;
+    uint8_t lo = (uint8_t)(v - div255((uint16_t)((uint16_t)v * s)));
+    uint8_t ramp = (uint8_t)(((uint16_t)(v - lo) * f + 128) >> 8);
+    uint8_t up = (uint8_t)(lo + ramp), down = (uint8_t)(v - ramp);
+    HUE_SECTOR(pos >> 8, v, lo, up, down, *r, *g, *b);
+}
+
+// Works in half steps (0..510) so l -/+ c/2 stays exact.
+static inline void hsl8_1(uint8_t h, uint8_t s, uint8_t l, uint8_t *r, uint8_t *g, uint8_t *b) {
+    uint16_t pos = (uint16_t)(h * 6);
+    uint8_t f = (uint8_t)pos;
+    uint16_t l2 = (uint16_t)(l * 2);
+    uint8_t c = (uint8_t)div255((uint16_t)(s * (l2 > 255 ? 510u - l2 : l2)));
+    uint16_t lo2 = (uint16_t)(l2 - c), hi2 = (uint16_t)(l2 + c);
+    uint32_t ramp = (uint32_t)c * f;   // half steps * 256
+    uint8_t lo = (uint8_t)((lo2 + 1) >> 1), hi = (uint8_t)((hi2 + 1) >> 1);
+    uint8_t up = (uint8_t)(((uint32_t)lo2 * 128 + ramp + 128) >> 8);
+    uint8_t down = (uint8_t)(((uint32_t)hi2 * 128 - ramp + 128) >> 8);
+    HUE_SECTOR(pos >> 8, hi, lo, up, down, *r, *g, *b);
+}
+
+static inline void hsv16_1(uint16_t h, uint16_t s, uint16_t v, uint32_t *r, uint32_t *g, uint32_t *b) {
+    uint32_t pos = (uint32_t)h * 6;
+    uint32_t f = pos & 0xFFFF;
+    uint32_t lo = v - mul16(v, s);
+    uint32_t ramp = ((v - lo) * f + 32768u) >> 16;
+    uint32_t up = lo + ramp, down = v - ramp;
+    HUE_SECTOR(pos >> 16, (uint32_t)v, lo, up, down, *r, *g, *b);
+}
+
+static inline void hsl16_1(uint16_t h, uint16_t s, uint16_t l, uint32_t *r, uint32_t *g, uint32_t *b) {
+    uint32_t pos = (uint32_t)h * 6;
+    uint32_t f = pos & 0xFFFF;
+    uint32_t l2 = (uint32_t)l * 2;
+    uint32_t c = mul16(s, l2 > 65535 ? 131070 - l2 : l2);
+    uint32_t lo2 = l2 - c, hi2 = l2 + c;
+    uint32_t ramp2 = (c * f + 16384u) >> 15;   // half steps
+    uint32_t lo = (lo2 + 1) >> 1, hi = (hi2 + 1) >> 1;
+    uint32_t up = (lo2 + ramp2 + 1) >> 1, down = (hi2 - ramp2 + 1) >> 1;
+    HUE_SECTOR(pos >> 16, hi, lo, up, down, *r, *g, *b);
+}
+
+// Sector numerator over 6 * delta turns, as in rgb2hsv.
+static inline uint32_t hue_num(uint8_t r, uint8_t g, uint8_t b, uint8_t max, uint8_t delta) {
+    int32_t t;
+    if (max == r)      t = (int32_t)g - b;
+    else if (max == g) t = (int32_t)b - r + 2 * delta;
+    else               t = (int32_t)r - g + 4 * delta;
+    return (uint32_t)(t < 0 ? t + 6 * delta : t);
+}
+
+static inline void rgb_minmax(uint8_t r, uint8_t g, uint8_t b, uint8_t *max, uint8_t *min) {
+    *max = r > g ? (r > b ? r : b) : (g > b ? g : b);
+    *min = r < g ? (r < b ? r : b) : (g < b ? g : b);
+}
+
+
+static void __h_S_v_8_2_r_G_b_8_8_8__(uint8_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b) {
+    hsv8_1(h, s, v, r, g, b);
+}
+
+static uint16_t __h_S_v_8_2_r_G_b_5_6_5__(uint8_t h, uint8_t s, uint8_t v) {
+    uint8_t r, g, b;
+    hsv8_1(h, s, v, &r, &g, &b);
+    return pack565_8(r, g, b);
+}
+
+static void __h_S_l_8_2_r_G_b_8_8_8__(uint8_t h, uint8_t s, uint8_t l, uint8_t *r, uint8_t *g, uint8_t *b) {
+    hsl8_1(h, s, l, r, g, b);
+}
+
+static uint16_t __h_S_l_8_2_r_G_b_5_6_5__(uint8_t h, uint8_t s, uint8_t l) {
+    uint8_t r, g, b;
+    hsl8_1(h, s, l, &r, &g, &b);
+    return pack565_8(r, g, b);
+}
+
+static void __h_S_v_1_6_2_r_G_b_8_8_8__(uint16_t h, uint16_t s, uint16_t v, uint8_t *r, uint8_t *g, uint8_t *b) {
+    uint32_t R, G, B;
+    hsv16_1(h, s, v, &R, &G, &B);
+    *r = to8_16(R);
+    *g = to8_16(G);
+    *b = to8_16(B);
+}
+
+static uint16_t __h_S_v_1_6_2_r_G_b_5_6_5__(uint16_t h, uint16_t s, uint16_t v) {
+    uint32_t R, G, B;
+    hsv16_1(h, s, v, &R, &G, &B);
+    return pack565_16(R, G, B);
+}
+
+static void __h_S_l_1_6_2_r_G_b_8_8_8__(uint16_t h, uint16_t s, uint16_t l, uint8_t *r, uint8_t *g, uint8_t *b) {
+    uint32_t R, G, B;
+    hsl16_1(h, s, l, &R, &G, &B);
+    *r = to8_16(R);
+    *g = to8_16(G);
+    *b = to8_16(B);
+}
+
+static uint16_t __h_S_l_1_6_2_r_G_b_5_6_5__(uint16_t h, uint16_t s, uint16_t l) {
+    uint32_t R, G, B;
+    hsl16_1(h, s, l, &R, &G, &B);
+    return pack565_16(R, G, B);
+}
+
+static void __r_G_b_8_8_8_2_h_S_v_1_6__(uint8_t r, uint8_t g, uint8_t b, uint16_t *h, uint16_t *s, uint16_t *v) {
+    uint8_t max, min;
+    rgb_minmax(r, g, b, &max, &min);
+    uint8_t delta = (uint8_t)(max - min);
+    *v = (uint16_t)(max * 257u);
+    if (delta == 0) {
+        *h = 0;
+        *s = 0;
+        return;
+    }
+    *s = (uint16_t)(((uint32_t)delta * 65535 + max / 2) / max);
+    *h = (uint16_t)((hue_num(r, g, b, max, delta) * 65536 + 3u * delta) / (6u * delta));
+}
+
+static void __r_G_b_8_8_8_2_h_S_l_1_6__(uint8_t r, uint8_t g, uint8_t b, uint16_t *h, uint16_t *s, uint16_t *l) {
+    uint8_t max, min;
+    rgb_minmax(r, g, b, &max, &min);
+    uint8_t delta = (uint8_t)(max - min);
+    uint16_t sum = (uint16_t)(max + min);
+    *l = (uint16_t)((sum * 257u + 1) >> 1);
+    if (delta == 0) {
+        *h = 0;
+        *s = 0;
+        return;
+    }
+    uint32_t den = sum > 255 ? 510u - sum : sum;
+    *s = (uint16_t)(((uint32_t)delta * 65535 + den / 2) / den);
+    *h = (uint16_t)((hue_num(r, g, b, max, delta) * 65536 + 3u * delta) / (6u * delta));
+}
+
+static void __r_G_b_8_8_8_2_h_S_v_8__(uint8_t r, uint8_t g, uint8_t b, uint8_t *h, uint8_t *s, uint8_t *v) {
+    uint8_t max, min;
+    rgb_minmax(r, g, b, &max, &min);
+    uint8_t delta = (uint8_t)(max - min);
+    *v = max;
+    if (delta == 0) {
+        *h = 0;
+        *s = 0;
+        return;
+    }
+    *s = (uint8_t)((delta * 255u + max / 2) / max);
+    *h = (uint8_t)((hue_num(r, g, b, max, delta) * 256 + 3u * delta) / (6u * delta));
+}
+
+static void __r_G_b_8_8_8_2_h_S_l_8__(uint8_t r, uint8_t g, uint8_t b, uint8_t *h, uint8_t *s, uint8_t *l) {
+    uint8_t max, min;
+    rgb_minmax(r, g, b, &max, &min);
+    uint8_t delta = (uint8_t)(max - min);
+    uint16_t sum = (uint16_t)(max + min);
+    *l = (uint8_t)((sum + 1) >> 1);
+    if (delta == 0) {
+        *h = 0;
+        *s = 0;
+        return;
+    }
+    uint16_t den = sum > 255 ? (uint16_t)(510 - sum) : sum;
+    *s = (uint8_t)((delta * 255u + den / 2) / den);
+    *h = (uint8_t)((hue_num(r, g, b, max, delta) * 256 + 3u * delta) / (6u * delta));
+}
+
+// LED strip batches: n interleaved (h, s, v|l) byte triplets in, n pixels out.
+static void __h_S_v_8_2_r_G_b_8_8_8_b_A_t_C_h__(const uint8_t *hsv, uint8_t *rgb, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    for (size_t i = 0; i < n; i++, hsv += 3, rgb += 3) hsv8_1(hsv[0], hsv[1], hsv[2], &rgb[0], &rgb[1], &rgb[2]);
+    STAT_SCOPE_END(scope, STAT_HSV8_2RGB_BATCH, n * 3);
+}
+
+static void __h_S_v_8_2_r_G_b_5_6_5_b_A_t_C_h__(const uint8_t *hsv, uint16_t *rgb565, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    for (size_t i = 0; i < n; i++, hsv += 3) {
+        uint8_t r, g, b;
+        hsv8_1(hsv[0], hsv[1], hsv[2], &r, &g, &b);
+        rgb565[i] = pack565_8(r, g, b);
+    }
+    STAT_SCOPE_END(scope, STAT_HSV8_2RGB_BATCH, n * 3);
+}
+
+static void __h_S_l_8_2_r_G_b_8_8_8_b_A_t_C_h__(const uint8_t *hsl, uint8_t *rgb, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    for (size_t i = 0; i < n; i++, hsl += 3, rgb += 3) hsl8_1(hsl[0], hsl[1], hsl[2], &rgb[0], &rgb[1], &rgb[2]);
+    STAT_SCOPE_END(scope, STAT_HSL8_2RGB_BATCH, n * 3);
+}
+
+static void __h_S_l_8_2_r_G_b_5_6_5_b_A_t_C_h__(const uint8_t *hsl, uint16_t *rgb565, size_t n) {
+    STAT_SCOPE_BEGIN(scope);
+    for (size_t i = 0; i < n; i++, hsl += 3) {
+        uint8_t r, g, b;
+        hsl8_1(hsl[0], hsl[1], hsl[2], &r, &g, &b);
+        rgb565[i] = pack565_8(r, g, b);
+    }
+    STAT_SCOPE_END(scope, STAT_HSL8_2RGB_BATCH, n * 3);
+}
+
+
+__attribute__((weak, alias("__h_S_v_8_2_r_G_b_8_8_8__"))) void hsv8_2rgb888(uint8_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b);
+__attribute__((weak, alias("__h_S_v_8_2_r_G_b_5_6_5__"))) uint16_t hsv8_2rgb565(uint8_t h, uint8_t s, uint8_t v);
+__attribute__((weak, alias("__h_S_l_8_2_r_G_b_8_8_8__"))) void hsl8_2rgb888(uint8_t h, uint8_t s, uint8_t l, uint8_t *r, uint8_t *g, uint8_t *b);
+__attribute__((weak, alias("__h_S_l_8_2_r_G_b_5_6_5__"))) uint16_t hsl8_2rgb565(uint8_t h, uint8_t s, uint8_t l);
+__attribute__((weak, alias("__h_S_v_1_6_2_r_G_b_8_8_8__"))) void hsv16_2rgb888(uint16_t h, uint16_t s, uint16_t v, uint8_t *r, uint8_t *g, uint8_t *b);
+__attribute__((weak, alias("__h_S_v_1_6_2_r_G_b_5_6_5__"))) uint16_t hsv16_2rgb565(uint16_t h, uint16_t s, uint16_t v);
+__attribute__((weak, alias("__h_S_l_1_6_2_r_G_b_8_8_8__"))) void hsl16_2rgb888(uint16_t h, uint16_t s, uint16_t l, uint8_t *r, uint8_t *g, uint8_t *b);
+__attribute__((weak, alias("__h_S_l_1_6_2_r_G_b_5_6_5__"))) uint16_t hsl16_2rgb565(uint16_t h, uint16_t s, uint16_t l);
+__attribute__((weak, alias("__r_G_b_8_8_8_2_h_S_v_1_6__"))) void rgb888_2hsv16(uint8_t r, uint8_t g, uint8_t b, uint16_t *h, uint16_t *s, uint16_t *v);
+__attribute__((weak, alias("__r_G_b_8_8_8_2_h_S_l_1_6__"))) void rgb888_2hsl16(uint8_t r, uint8_t g, uint8_t b, uint16_t *h, uint16_t *s, uint16_t *l);
+__attribute__((weak, alias("__r_G_b_8_8_8_2_h_S_v_8__"))) void rgb888_2hsv8(uint8_t r, uint8_t g, uint8_t b, uint8_t *h, uint8_t *s, uint8_t *v);
+__attribute__((weak, alias("__r_G_b_8_8_8_2_h_S_l_8__"))) void rgb888_2hsl8(uint8_t r, uint8_t g, uint8_t b, uint8_t *h, uint8_t *s, uint8_t *l);
+__attribute__((weak, alias("__h_S_v_8_2_r_G_b_8_8_8_b_A_t_C_h__"))) void hsv8_2rgb888_batch(const uint8_t *hsv, uint8_t *rgb, size_t n);
+__attribute__((weak, alias("__h_S_v_8_2_r_G_b_5_6_5_b_A_t_C_h__"))) void hsv8_2rgb565_batch(const uint8_t *hsv, uint16_t *rgb565, size_t n);
+__attribute__((weak, alias("__h_S_l_8_2_r_G_b_8_8_8_b_A_t_C_h__"))) void hsl8_2rgb888_batch(const uint8_t *hsl, uint8_t *rgb, size_t n);
+__attribute__((weak, alias("__h_S_l_8_2_r_G_b_5_6_5_b_A_t_C_h__"))) void hsl8_2rgb565_batch(const uint8_t *hsl, uint16_t *rgb565, size_t n);
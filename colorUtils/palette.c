@@ -0,0 +1,203 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "colorutl.h"
+#include <statUtils/statutl.h>
+
+// Nearest-colour search against an arbitrary palette.
+//
+// Distance is weighted RGB, 2*dr^2 + 4*dg^2 + 3*db^2: cheap, and much closer
+// to what the eye sees than plain Euclidean RGB. Because the weights are per
+// channel, the distance from an entry to an axis-aligned box has a simple
+// lower and upper bound. The colour cube is split into 16x16x16 cells, and
+// each cell keeps only the entries whose lower bound is within the smallest
+// upper bound over the palette. Every colour in the cell has its nearest
+// entry in that list, so lookups stay exact (ties go to the lower index, as
+// in a brute-force loop) while scanning a few entries instead of all.
+
+#define PALETTE_CELL_SHIFT 4
+#define PALETTE_GRID       (256 >> PALETTE_CELL_SHIFT)
+#define PALETTE_CELLS      (PALETTE_GRID * PALETTE_GRID * PALETTE_GRID)
+
+static const uint32_t PAL_W[3] = { 2, 4, 3 };
+
+static inline uint32_t pal_dist(const uint8_t *e, int r, int g, int b) {
+    int dr = e[0] - r, dg = e[1] - g, db = e[2] - b;
+    return (uint32_t)(2 * dr * dr + 4 * dg * dg + 3 * db * db);
+}
+
+static inline unsigned pal_cell(uint8_t r, uint8_t g, uint8_t b) {
+    return ((unsigned)(r >> PALETTE_CELL_SHIFT) * PALETTE_GRID + (g >> PALETTE_CELL_SHIFT)) * PALETTE_GRID +
+           (b >> PALETTE_CELL_SHIFT);
+}
+
+static inline uint8_t pal_nearest(const palette_t *pal, uint8_t r, uint8_t g, uint8_t b) {
+    unsigned cell = pal_cell(r, g, b);
+    const uint8_t *c = pal->cand + pal->cellStart[cell];
+    const uint8_t *end = pal->cand + pal->cellStart[cell + 1];
+    uint8_t best = *c;
+    if (end - c == 1) return best;
+    uint32_t bestDist = UINT32_MAX;
+    for (; c < end; c++) {
+        uint32_t d = pal_dist(pal->rgb888[*c], r, g, b);
+        if (d < bestDist) {
+            bestDist = d;
+            best = *c;
+        }
+    }
+    return best;
+}
+
+// Candidate entries for one cell, in index order; returns how many. Entries
+// flagged in dup repeat an earlier colour and can never win.
+static size_t pal_cell_candidates(const palette_t *pal, const uint8_t *dup, unsigned cell, uint8_t *out) {
+    int lo[3] = { (int)(cell / (PALETTE_GRID * PALETTE_GRID)), (int)(cell / PALETTE_GRID % PALETTE_GRID),
+                  (int)(cell % PALETTE_GRID) };
+    uint32_t minD[PALETTE_MAX_SIZE];
+    uint32_t bound = UINT32_MAX;
+    for (int k = 0; k < 3; k++) lo[k] <<= PALETTE_CELL_SHIFT;
+    for (unsigned i = 0; i < pal->size; i++) {
+        uint32_t dmin = 0, dmax = 0;
+        for (int k = 0; k < 3; k++) {
+            int v = pal->rgb888[i][k], hi = lo[k] + (1 << PALETTE_CELL_SHIFT) - 1;
+            int near = v < lo[k] ? lo[k] - v : (v > hi ? v - hi : 0);
+            int far = (v - lo[k] > hi - v) ? v - lo[k] : hi - v;
+            dmin += PAL_W[k] * (uint32_t)(near * near);
+            dmax += PAL_W[k] * (uint32_t)(far * far);
+        }
+        minD[i] = dmin;
+        if (dmax < bound) bound = dmax;
+    }
+    size_t n = 0;
+    for (unsigned i = 0; i < pal->size; i++) {
+        if (!dup[i] && minD[i] <= bound) {
+            if (out) out[n] = (uint8_t)i;
+            n++;
+        }
+    }
+    return n;
+}
+
+static int __p_A_l_E_t_T_e_I_n_I_t__(palette_t *pal, const uint8_t *rgb, size_t n) {
+    if (!pal) return -1;
+    memset(pal, 0, sizeof(*pal));
+    if (!rgb || n == 0 || n > PALETTE_MAX_SIZE) return -1;
+    uint8_t dup[PALETTE_MAX_SIZE] = { 0 };
+    pal->size = (uint16_t)n;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(pal->rgb888[i], rgb + 3 * i, 3);
+        pal->rgb565[i] = rgb888_2rgb565(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+        for (size_t k = 0; k < i && !dup[i]; k++) dup[i] = memcmp(pal->rgb888[k], pal->rgb888[i], 3) == 0;
+    }
+
+    pal->cellStart = (uint32_t *)malloc((PALETTE_CELLS + 1) * sizeof(uint32_t));
+    if (!pal->cellStart) return -1;
+    uint32_t total = 0;
+    for (unsigned c = 0; c < PALETTE_CELLS; c++) {
+        pal->cellStart[c] = total;
+        total += (uint32_t)pal_cell_candidates(pal, dup, c, NULL);
+    }
+    pal->cellStart[PALETTE_CELLS] = total;
+    pal->cand = (uint8_t *)malloc(total);
+    if (!pal->cand) {
+        free(pal->cellStart);
+        pal->cellStart = NULL;
+        return -1;
+    }
+    for (unsigned c = 0; c < PALETTE_CELLS; c++) pal_cell_candidates(pal, dup, c, pal->cand + pal->cellStart[c]);
+    return 0;
+}
+
+static void __p_A_l_E_t_T_e_F_r_E_e__(palette_t *pal) {
+    if (!pal) return;
+    free(pal->cellStart);
+    free(pal->cand);
+    pal->cellStart = NULL;
+    pal->cand = NULL;
+    pal->size = 0;
+}
+
+static uint8_t __p_A_l_E_t_T_e_N_e_A_r_E_s_T__(const palette_t *pal, uint8_t r, uint8_t g, uint8_t b) {
+    if (!pal || !pal->cand) return 0;
+    return pal_nearest(pal, r, g, b);
+}
+
+static void __p_A_l_E_t_T_e_M_a_P_r_G_b_8_8_8__(const palette_t *pal, const uint8_t *src, uint8_t *dst, size_t n) {
+    if (!pal || !pal->cand || !src || !dst) return;
+    STAT_SCOPE_BEGIN(scope);
+    for (size_t i = 0; i < n; i++, src += 3) dst[i] = pal_nearest(pal, src[0], src[1], src[2]);
+    STAT_SCOPE_END(scope, STAT_PALETTE_MAP, n * 3);
+}
+
+static void __p_A_l_E_t_T_e_M_a_P_r_G_b_5_6_5__(const palette_t *pal, const uint16_t *src, uint8_t *dst, size_t n) {
+    if (!pal || !pal->cand || !src || !dst) return;
+    STAT_SCOPE_BEGIN(scope);
+    for (size_t i = 0; i < n; i++) {
+        uint8_t r, g, b;
+        rgb565_2rgb888(src[i], &r, &g, &b);
+        dst[i] = pal_nearest(pal, r, g, b);
+    }
+    STAT_SCOPE_END(scope, STAT_PALETTE_MAP, n * sizeof(uint16_t));
+}
+
+static inline uint8_t clamp8(int v) {
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Floyd-Steinberg with serpentine scan. Errors are kept in 1/16 steps in two
+// row buffers with a guard pixel on each side.
+static int __p_A_l_E_t_T_e_D_i_T_h_E_r_R_g_B_8_8_8__(const palette_t *pal, uint8_t *dst, size_t dst_stride,
+                                                      const uint8_t *src, size_t src_stride,
+                                                      size_t width, size_t height) {
+    if (!pal || !pal->cand || !dst || !src) return -1;
+    if (!dst_stride) dst_stride = width;
+    if (!src_stride) src_stride = width * 3;
+    size_t row = (width + 2) * 3;
+    int32_t *err = (int32_t *)calloc(2 * row, sizeof(int32_t));
+    if (!err) return -1;
+    STAT_SCOPE_BEGIN(scope);
+
+    int32_t *cur = err, *next = err + row;
+    for (size_t y = 0; y < height; y++) {
+        const uint8_t *s = src + y * src_stride;
+        uint8_t *d = dst + y * dst_stride;
+        int rtl = (int)(y & 1), dir = rtl ? -1 : 1;
+        memset(next, 0, row * sizeof(int32_t));
+        for (size_t k = 0; k < width; k++) {
+            size_t x = rtl ? width - 1 - k : k;
+            int32_t *e = cur + (x + 1) * 3, *en = next + (x + 1) * 3;
+            int v[3];
+            for (int c = 0; c < 3; c++) v[c] = clamp8(s[3 * x + c] + (e[c] + (e[c] < 0 ? -8 : 8)) / 16);
+            uint8_t idx = pal_nearest(pal, (uint8_t)v[0], (uint8_t)v[1], (uint8_t)v[2]);
+            d[x] = idx;
+            for (int c = 0; c < 3; c++) {
+                int32_t q = v[c] - pal->rgb888[idx][c];
+                e[3 * dir + c] += q * 7;
+                en[-3 * dir + c] += q * 3;
+                en[c] += q * 5;
+                en[3 * dir + c] += q;
+            }
+        }
+        int32_t *t = cur;
+        cur = next;
+        next = t;
+    }
+
+    STAT_SCOPE_END(scope, STAT_PALETTE_MAP, width * height * 3);
+    free(err);
+    return 0;
+}
+
+
+__attribute__((weak, alias("__p_A_l_E_t_T_e_I_n_I_t__"))) int paletteInit(palette_t *pal, const uint8_t *rgb, size_t n);
+__attribute__((weak, alias("__p_A_l_E_t_T_e_F_r_E_e__"))) void paletteFree(palette_t *pal);
+__attribute__((weak, alias("__p_A_l_E_t_T_e_N_e_A_r_E_s_T__"))) uint8_t paletteNearest(const palette_t *pal, uint8_t r, uint8_t g, uint8_t b);
+__attribute__((weak, alias("__p_A_l_E_t_T_e_M_a_P_r_G_b_8_8_8__")))
+void paletteMapRGB888(const palette_t *pal, const uint8_t *src, uint8_t *dst, size_t n);
+__attribute__((weak, alias("__p_A_l_E_t_T_e_M_a_P_r_G_b_5_6_5__")))
+void paletteMapRGB565(const palette_t *pal, const uint16_t *src, uint8_t *dst, size_t n);
+__attribute__((weak, alias("__p_A_l_E_t_T_e_D_i_T_h_E_r_R_g_B_8_8_8__")))
+int paletteDitherRGB888(const palette_t *pal, uint8_t *dst, size_t dst_stride, const uint8_t *src, size_t src_stride,
+                        size_t width, size_t height);
@@ -0,0 +1,742 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "colorutl.h"
+#include <statUtils/statutl.h>
+#include "cpulevel.h"
+
+// Generic pixel-format conversion engine.
+//
+// Every (src, dst) pair either has a specialized row kernel in PIXCONV_DIRECT,
+// or goes src -> ARGB32 -> dst through a small stack chunk. The per-pixel
+// arithmetic matches the single-pixel functions (rgb888_2rgb565, rgb565_2rgb888,
+// rgb888_2gray, rgb565_2gray, gray2_1bit, f01_2rgb888, f01_2rgb565, rgb565_2f01,
+// rgb888_2f01), so a conversion gives the same pixels as chaining them.
+
+#define PIXCONV_CHUNK 256   // pixels per chunk on the generic path, multiple of 8 for GRAY1
+
+// Per-channel gray weights, r * 0.299f etc. Summing table entries in the same
+// order as rgb888_2gray gives bit-identical results without the int->float work.
+typedef struct {
+    float r[256], g[256], b[256];
+} pixconv_gray_t;
+
+// Row kernel: convert n pixels from src to dst. lut is only valid for gray destinations.
+#define PIXCONV_ROW_ARGS void *dst, const void *src, size_t n, __attribute__((unused)) const pixconv_gray_t *lut
+
+typedef void (*pixconv_row_t)(PIXCONV_ROW_ARGS);
+
+static const uint8_t PIXFMT_BITS[PIXFMT_COUNT] = {
+    [PIXFMT_ARGB32] = 32,
+    [PIXFMT_RGBA32] = 32,
+    [PIXFMT_RGB565] = 16,
+    [PIXFMT_RGB888] = 24,
+    [PIXFMT_F01]    = 96,
+    [PIXFMT_GRAY8]  = 8,
+    [PIXFMT_GRAY1]  = 1
+};
+
+static void gray_lut_init(pixconv_gray_t *lut) {
+    for (int i = 0; i < 256; i++) {
+        lut->r[i] = i * 0.299f;
+        lut->g[i] = i * 0.587f;
+        lut->b[i] = i * 0.114f;
+    }
+}
+
+static inline uint8_t gray_of(const pixconv_gray_t *lut, uint8_t r, uint8_t g, uint8_t b) {
+    return (uint8_t)(lut->r[r] + lut->g[g] + lut->b[b] + 0.5f);
+}
+
+static inline uint8_t f01_to8(float x) {
+    return (uint8_t)(CLAMP01(x) * 255 + 0.5f);
+}
+
+// --- anything -> ARGB32 ---------------------------------------------------
+
+static void argb32_from_argb32(PIXCONV_ROW_ARGS) {
+    memmove(dst, src, n * 4);
+}
+
+static void argb32_from_rgba32(PIXCONV_ROW_ARGS) {
+    ARGB32_t *d = (ARGB32_t *)dst;
+    const RGBA32_t *s = (const RGBA32_t *)src;
+    for (size_t i = 0; i < n; i++) d[i] = (s[i] >> 8) | (s[i] << 24);
+}
+
+static void argb32_from_rgb565(PIXCONV_ROW_ARGS) {
+    ARGB32_t *d = (ARGB32_t *)dst;
+    const uint16_t *s = (const uint16_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t p = s[i];
+        d[i] = 0xFF000000u | ((p & 0xF800) << 8) | ((p & 0x07E0) << 5) | ((p & 0x001F) << 3);
+    }
+}
+
+static void argb32_from_rgb888(PIXCONV_ROW_ARGS) {
+    ARGB32_t *d = (ARGB32_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    for (size_t i = 0; i < n; i++, s += 3) d[i] = ARGB32_GET(0xFFu, (uint32_t)s[0], (uint32_t)s[1], (uint32_t)s[2]);
+}
+
+static void argb32_from_f01(PIXCONV_ROW_ARGS) {
+    ARGB32_t *d = (ARGB32_t *)dst;
+    const float *s = (const float *)src;
+    for (size_t i = 0; i < n; i++, s += 3)
+        d[i] = ARGB32_GET(0xFFu, (uint32_t)f01_to8(s[0]), (uint32_t)f01_to8(s[1]), (uint32_t)f01_to8(s[2]));
+}
+
+static void argb32_from_gray8(PIXCONV_ROW_ARGS) {
+    ARGB32_t *d = (ARGB32_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    for (size_t i = 0; i < n; i++) d[i] = 0xFF000000u | (s[i] * 0x010101u);
+}
+
+static void argb32_from_gray1(PIXCONV_ROW_ARGS) {
+    ARGB32_t *d = (ARGB32_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    for (size_t i = 0; i < n; i++) d[i] = ((s[i >> 3] >> (7 - (i & 7))) & 1) ? 0xFFFFFFFFu : 0xFF000000u;
+}
+
+// --- ARGB32 -> anything ---------------------------------------------------
+
+static void rgba32_from_argb32(PIXCONV_ROW_ARGS) {
+    RGBA32_t *d = (RGBA32_t *)dst;
+    const ARGB32_t *s = (const ARGB32_t *)src;
+    for (size_t i = 0; i < n; i++) d[i] = (s[i] << 8) | (s[i] >> 24);
+}
+
+static void rgb565_from_argb32(PIXCONV_ROW_ARGS) {
+    uint16_t *d = (uint16_t *)dst;
+    const ARGB32_t *s = (const ARGB32_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t p = s[i];
+        d[i] = (uint16_t)(((p >> 8) & 0xF800) | ((p >> 5) & 0x07E0) | ((p >> 3) & 0x001F));
+    }
+}
+
+static void rgb888_from_argb32(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const ARGB32_t *s = (const ARGB32_t *)src;
+    for (size_t i = 0; i < n; i++, d += 3) {
+        uint32_t p = s[i];
+        d[0] = ARGB32_GET_R(p);
+        d[1] = ARGB32_GET_G(p);
+        d[2] = ARGB32_GET_B(p);
+    }
+}
+
+static void f01_from_argb32(PIXCONV_ROW_ARGS) {
+    float *d = (float *)dst;
+    const ARGB32_t *s = (const ARGB32_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t p = s[i];
+        d[3 * i + 0] = ARGB32_GET_R(p) / 255.0f;
+        d[3 * i + 1] = ARGB32_GET_G(p) / 255.0f;
+        d[3 * i + 2] = ARGB32_GET_B(p) / 255.0f;
+    }
+}
+
+static void gray8_from_argb32(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const ARGB32_t *s = (const ARGB32_t *)src;
+    for (size_t i = 0; i < n; i++) d[i] = gray_of(lut, ARGB32_GET_R(s[i]), ARGB32_GET_G(s[i]), ARGB32_GET_B(s[i]));
+}
+
+static void gray1_from_gray8(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8_t byte = 0;
+        for (int k = 0; k < 8; k++) byte = (uint8_t)((byte << 1) | (s[i + k] >> 7));
+        d[i >> 3] = byte;
+    }
+    if (i < n) {
+        // Partial last byte: keep the padding bits of the destination.
+        uint8_t byte = d[i >> 3];
+        for (int k = 0; i + k < n; k++) {
+            uint8_t bit = (uint8_t)(0x80 >> k);
+            byte = (s[i + k] >= 128) ? (byte | bit) : (byte & ~bit);
+        }
+        d[i >> 3] = byte;
+    }
+}
+
+static void gray1_from_argb32(PIXCONV_ROW_ARGS) {
+    uint8_t gray[PIXCONV_CHUNK];
+    gray8_from_argb32(gray, src, n, lut);   // n <= PIXCONV_CHUNK on the generic path
+    gray1_from_gray8(dst, gray, n, lut);
+}
+
+// --- vector row bodies ----------------------------------------------------
+//
+// RGB888 <-> RGB565 and RGB888 / RGB565 -> GRAY8 / GRAY1 run on SSE2 or AVX2
+// as cpuLevel() allows. Gray is computed with the same float multiplies and
+// adds, in the same order, as gray_of() on the LUT, so every level gives the
+// same bytes. A body converts as many whole vectors as fit, loads all of an
+// iteration's input before storing (RGB888 -> RGB565 / gray may run in place),
+// and reports how many pixels it did; the scalar loop finishes the row.
+
+// Reverses the bit order inside each byte: movemask puts pixel 0 in bit 0,
+// GRAY1 wants it in the MSB.
+static inline uint32_t bitrev_bytes(uint32_t m) {
+    m = ((m >> 4) & 0x0F0F0F0Fu) | ((m & 0x0F0F0F0Fu) << 4);
+    m = ((m >> 2) & 0x33333333u) | ((m & 0x33333333u) << 2);
+    return ((m >> 1) & 0x55555555u) | ((m & 0x55555555u) << 1);
+}
+
+#if defined(__SSE2__)
+
+// Four RGB888 pixels (exactly 12 bytes read) as three 32-bit channel vectors.
+static inline void rgb888_load4_sse2(const uint8_t *s, __m128i *r, __m128i *g, __m128i *b) {
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t tail;
+    memcpy(&tail, s + 8, 4);
+    __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)s), _mm_cvtsi32_si128((int)tail));
+    __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+    __m128 v0 = _mm_castsi128_ps(_mm_unpacklo_epi16(lo, zero));   // r0 g0 b0 r1
+    __m128 v1 = _mm_castsi128_ps(_mm_unpackhi_epi16(lo, zero));   // g1 b1 r2 g2
+    __m128 v2 = _mm_castsi128_ps(_mm_unpacklo_epi16(hi, zero));   // b2 r3 g3 b3
+    __m128 x = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2));   // r2 r2 r3 r3
+    *r = _mm_castps_si128(_mm_shuffle_ps(v0, x, _MM_SHUFFLE(2, 0, 3, 0)));
+    x = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1));          // g0 g0 g1 g1
+    __m128 y = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3));   // g2 g2 g3 g3
+    *g = _mm_castps_si128(_mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0)));
+    x = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2));          // b0 b0 b1 b1
+    *b = _mm_castps_si128(_mm_shuffle_ps(x, v2, _MM_SHUFFLE(3, 0, 2, 0)));
+}
+
+// Zero-extended RGB565 pixels to the 8-bit channels of rgb565_2rgb888.
+static inline void rgb565_split_sse2(__m128i p, __m128i *r, __m128i *g, __m128i *b) {
+    *r = _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xF8));
+    *g = _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0xFC));
+    *b = _mm_and_si128(_mm_slli_epi32(p, 3), _mm_set1_epi32(0xF8));
+}
+
+static inline __m128i gray4_sse2(__m128i r, __m128i g, __m128i b) {
+    __m128 y = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(r), _mm_set1_ps(0.299f)),
+                          _mm_mul_ps(_mm_cvtepi32_ps(g), _mm_set1_ps(0.587f)));
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_cvtepi32_ps(b), _mm_set1_ps(0.114f)));
+    return _mm_cvttps_epi32(_mm_add_ps(y, _mm_set1_ps(0.5f)));
+}
+
+// RGB565 words, sign-extended so packs_epi32 keeps all 16 bits.
+static inline __m128i pack565_sse2(__m128i r, __m128i g, __m128i b) {
+    __m128i p = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(r, _mm_set1_epi32(0xF8)), 8),
+                             _mm_or_si128(_mm_slli_epi32(_mm_and_si128(g, _mm_set1_epi32(0xFC)), 3),
+                                          _mm_srli_epi32(b, 3)));
+    return _mm_srai_epi32(_mm_slli_epi32(p, 16), 16);
+}
+
+static inline __m128i gray16_rgb888_sse2(const uint8_t *s) {
+    __m128i r, g, b, y[4];
+    for (int k = 0; k < 4; k++) {
+        rgb888_load4_sse2(s + 12 * k, &r, &g, &b);
+        y[k] = gray4_sse2(r, g, b);
+    }
+    return _mm_packus_epi16(_mm_packs_epi32(y[0], y[1]), _mm_packs_epi32(y[2], y[3]));
+}
+
+static inline __m128i gray16_rgb565_sse2(const uint16_t *s) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i p0 = _mm_loadu_si128((const __m128i *)s), p1 = _mm_loadu_si128((const __m128i *)(s + 8));
+    __m128i q[4] = { _mm_unpacklo_epi16(p0, zero), _mm_unpackhi_epi16(p0, zero),
+                     _mm_unpacklo_epi16(p1, zero), _mm_unpackhi_epi16(p1, zero) };
+    __m128i r, g, b, y[4];
+    for (int k = 0; k < 4; k++) {
+        rgb565_split_sse2(q[k], &r, &g, &b);
+        y[k] = gray4_sse2(r, g, b);
+    }
+    return _mm_packus_epi16(_mm_packs_epi32(y[0], y[1]), _mm_packs_epi32(y[2], y[3]));
+}
+
+static void rgb565_from_rgb888_sse2(uint16_t *d, const uint8_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, s += 24) {
+        __m128i r0, g0, b0, r1, g1, b1;
+        rgb888_load4_sse2(s, &r0, &g0, &b0);
+        rgb888_load4_sse2(s + 12, &r1, &g1, &b1);
+        _mm_storeu_si128((__m128i *)(d + i), _mm_packs_epi32(pack565_sse2(r0, g0, b0), pack565_sse2(r1, g1, b1)));
+    }
+    *done = i;
+}
+
+// Four pixels as 0x00BBGGRR dwords -> 12 packed bytes, the top 4 bytes zero.
+static inline __m128i rgb888_pack4_sse2(__m128i p) {
+    __m128i r, g, b;
+    rgb565_split_sse2(p, &r, &g, &b);
+    __m128i x = _mm_or_si128(r, _mm_or_si128(_mm_slli_epi32(g, 8), _mm_slli_epi32(b, 16)));
+    // 6 bytes per 64-bit half, then close the gap between the halves.
+    x = _mm_or_si128(_mm_and_si128(x, _mm_set1_epi64x(0xFFFFFF)),
+                     _mm_and_si128(_mm_srli_epi64(x, 8), _mm_set1_epi64x(0xFFFFFF000000LL)));
+    return _mm_or_si128(_mm_move_epi64(x), _mm_slli_si128(_mm_srli_si128(x, 8), 6));
+}
+
+static void rgb888_from_rgb565_sse2(uint8_t *d, const uint16_t *s, size_t n, size_t *done) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16, d += 48) {
+        __m128i p0 = _mm_loadu_si128((const __m128i *)(s + i)), p1 = _mm_loadu_si128((const __m128i *)(s + i + 8));
+        __m128i c0 = rgb888_pack4_sse2(_mm_unpacklo_epi16(p0, zero)), c1 = rgb888_pack4_sse2(_mm_unpackhi_epi16(p0, zero));
+        __m128i c2 = rgb888_pack4_sse2(_mm_unpacklo_epi16(p1, zero)), c3 = rgb888_pack4_sse2(_mm_unpackhi_epi16(p1, zero));
+        _mm_storeu_si128((__m128i *)d, _mm_or_si128(c0, _mm_slli_si128(c1, 12)));
+        _mm_storeu_si128((__m128i *)(d + 16), _mm_or_si128(_mm_srli_si128(c1, 4), _mm_slli_si128(c2, 8)));
+        _mm_storeu_si128((__m128i *)(d + 32), _mm_or_si128(_mm_srli_si128(c2, 8), _mm_slli_si128(c3, 4)));
+    }
+    *done = i;
+}
+
+static void gray8_from_rgb888_sse2(uint8_t *d, const uint8_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) _mm_storeu_si128((__m128i *)(d + i), gray16_rgb888_sse2(s + 3 * i));
+    *done = i;
+}
+
+static void gray8_from_rgb565_sse2(uint8_t *d, const uint16_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) _mm_storeu_si128((__m128i *)(d + i), gray16_rgb565_sse2(s + i));
+    *done = i;
+}
+
+static void gray1_from_rgb888_sse2(uint8_t *d, const uint8_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint16_t bits = (uint16_t)bitrev_bytes((uint32_t)_mm_movemask_epi8(gray16_rgb888_sse2(s + 3 * i)));
+        memcpy(d + (i >> 3), &bits, 2);
+    }
+    *done = i;
+}
+
+static void gray1_from_rgb565_sse2(uint8_t *d, const uint16_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint16_t bits = (uint16_t)bitrev_bytes((uint32_t)_mm_movemask_epi8(gray16_rgb565_sse2(s + i)));
+        memcpy(d + (i >> 3), &bits, 2);
+    }
+    *done = i;
+}
+
+#endif // __SSE2__
+
+#if COLORUTL_X86_DISPATCH
+
+// pshufb indices taking one channel of four RGB888 pixels into zero-extended dwords.
+#define PIXCONV_PICK4(k) k, -1, -1, -1, k + 3, -1, -1, -1, k + 6, -1, -1, -1, k + 9, -1, -1, -1
+
+// Eight RGB888 pixels (exactly 24 bytes read): pixels 0-3 from the low lane
+// loaded at s, pixels 4-7 from the high lane loaded at s + 8.
+AVX2_FN void rgb888_load8_avx2(const uint8_t *s, __m256i *r, __m256i *g, __m256i *b) {
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)s)),
+                                        _mm_loadu_si128((const __m128i *)(s + 8)), 1);
+    *r = _mm256_shuffle_epi8(v, _mm256_setr_epi8(PIXCONV_PICK4(0), PIXCONV_PICK4(4)));
+    *g = _mm256_shuffle_epi8(v, _mm256_setr_epi8(PIXCONV_PICK4(1), PIXCONV_PICK4(5)));
+    *b = _mm256_shuffle_epi8(v, _mm256_setr_epi8(PIXCONV_PICK4(2), PIXCONV_PICK4(6)));
+}
+
+AVX2_FN void rgb565_split_avx2(__m256i p, __m256i *r, __m256i *g, __m256i *b) {
+    *r = _mm256_and_si256(_mm256_srli_epi32(p, 8), _mm256_set1_epi32(0xF8));
+    *g = _mm256_and_si256(_mm256_srli_epi32(p, 3), _mm256_set1_epi32(0xFC));
+    *b = _mm256_and_si256(_mm256_slli_epi32(p, 3), _mm256_set1_epi32(0xF8));
+}
+
+AVX2_FN __m256i gray8_avx2(__m256i r, __m256i g, __m256i b) {
+    __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(r), _mm256_set1_ps(0.299f)),
+                             _mm256_mul_ps(_mm256_cvtepi32_ps(g), _mm256_set1_ps(0.587f)));
+    y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_cvtepi32_ps(b), _mm256_set1_ps(0.114f)));
+    return _mm256_cvttps_epi32(_mm256_add_ps(y, _mm256_set1_ps(0.5f)));
+}
+
+AVX2_FN __m256i pack565_avx2(__m256i r, __m256i g, __m256i b) {
+    return _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(r, _mm256_set1_epi32(0xF8)), 8),
+                           _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(g, _mm256_set1_epi32(0xFC)), 3),
+                                           _mm256_srli_epi32(b, 3)));
+}
+
+// Four vectors of eight 32-bit gray values -> 32 bytes in pixel order (the
+// packs work per 128-bit lane).
+AVX2_FN __m256i gray_pack32_avx2(const __m256i *y) {
+    __m256i v = _mm256_packus_epi16(_mm256_packs_epi32(y[0], y[1]), _mm256_packs_epi32(y[2], y[3]));
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+AVX2_FN __m256i gray32_rgb888_avx2(const uint8_t *s) {
+    __m256i r, g, b, y[4];
+    for (int k = 0; k < 4; k++) {
+        rgb888_load8_avx2(s + 24 * k, &r, &g, &b);
+        y[k] = gray8_avx2(r, g, b);
+    }
+    return gray_pack32_avx2(y);
+}
+
+AVX2_FN __m256i gray32_rgb565_avx2(const uint16_t *s) {
+    __m256i r, g, b, y[4];
+    for (int k = 0; k < 4; k++) {
+        rgb565_split_avx2(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(s + 8 * k))), &r, &g, &b);
+        y[k] = gray8_avx2(r, g, b);
+    }
+    return gray_pack32_avx2(y);
+}
+
+__attribute__((target("avx2")))
+static void rgb565_from_rgb888_avx2(uint16_t *d, const uint8_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16, s += 48) {
+        __m256i r0, g0, b0, r1, g1, b1;
+        rgb888_load8_avx2(s, &r0, &g0, &b0);
+        rgb888_load8_avx2(s + 24, &r1, &g1, &b1);
+        __m256i v = _mm256_packus_epi32(pack565_avx2(r0, g0, b0), pack565_avx2(r1, g1, b1));
+        _mm256_storeu_si256((__m256i *)(d + i), _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    *done = i;
+}
+
+__attribute__((target("avx2")))
+static void rgb888_from_rgb565_avx2(uint8_t *d, const uint16_t *s, size_t n, size_t *done) {
+    const __m256i squeeze = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                             0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i join = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, d += 24) {
+        __m256i r, g, b;
+        rgb565_split_avx2(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(s + i))), &r, &g, &b);
+        __m256i x = _mm256_or_si256(r, _mm256_or_si256(_mm256_slli_epi32(g, 8), _mm256_slli_epi32(b, 16)));
+        x = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(x, squeeze), join);   // 24 bytes in order
+        _mm_storeu_si128((__m128i *)d, _mm256_castsi256_si128(x));
+        _mm_storel_epi64((__m128i *)(d + 16), _mm256_extracti128_si256(x, 1));
+    }
+    *done = i;
+}
+
+__attribute__((target("avx2")))
+static void gray8_from_rgb888_avx2(uint8_t *d, const uint8_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) _mm256_storeu_si256((__m256i *)(d + i), gray32_rgb888_avx2(s + 3 * i));
+    *done = i;
+}
+
+__attribute__((target("avx2")))
+static void gray8_from_rgb565_avx2(uint8_t *d, const uint16_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) _mm256_storeu_si256((__m256i *)(d + i), gray32_rgb565_avx2(s + i));
+    *done = i;
+}
+
+__attribute__((target("avx2")))
+static void gray1_from_rgb888_avx2(uint8_t *d, const uint8_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint32_t bits = bitrev_bytes((uint32_t)_mm256_movemask_epi8(gray32_rgb888_avx2(s + 3 * i)));
+        memcpy(d + (i >> 3), &bits, 4);
+    }
+    *done = i;
+}
+
+__attribute__((target("avx2")))
+static void gray1_from_rgb565_avx2(uint8_t *d, const uint16_t *s, size_t n, size_t *done) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint32_t bits = bitrev_bytes((uint32_t)_mm256_movemask_epi8(gray32_rgb565_avx2(s + i)));
+        memcpy(d + (i >> 3), &bits, 4);
+    }
+    *done = i;
+}
+
+#endif // COLORUTL_X86_DISPATCH
+
+// Vector row bodies for the active level; NULL leaves the whole row to the scalar loop.
+typedef struct {
+    void (*rgb565_from_rgb888)(uint16_t *d, const uint8_t *s, size_t n, size_t *done);
+    void (*rgb888_from_rgb565)(uint8_t *d, const uint16_t *s, size_t n, size_t *done);
+    void (*gray8_from_rgb888)(uint8_t *d, const uint8_t *s, size_t n, size_t *done);
+    void (*gray8_from_rgb565)(uint8_t *d, const uint16_t *s, size_t n, size_t *done);
+    void (*gray1_from_rgb888)(uint8_t *d, const uint8_t *s, size_t n, size_t *done);
+    void (*gray1_from_rgb565)(uint8_t *d, const uint16_t *s, size_t n, size_t *done);
+} pixconv_impl_t;
+
+static const pixconv_impl_t PIXCONV_SCALAR = { NULL, NULL, NULL, NULL, NULL, NULL };
+#if defined(__SSE2__)
+static const pixconv_impl_t PIXCONV_SSE2 = { rgb565_from_rgb888_sse2, rgb888_from_rgb565_sse2, gray8_from_rgb888_sse2,
+                                             gray8_from_rgb565_sse2,  gray1_from_rgb888_sse2,  gray1_from_rgb565_sse2 };
+#endif
+#if COLORUTL_X86_DISPATCH
+static const pixconv_impl_t PIXCONV_AVX2 = { rgb565_from_rgb888_avx2, rgb888_from_rgb565_avx2, gray8_from_rgb888_avx2,
+                                             gray8_from_rgb565_avx2,  gray1_from_rgb888_avx2,  gray1_from_rgb565_avx2 };
+#endif
+
+static const pixconv_impl_t *pixconv_impl(void) {
+    return CPU_LEVEL_DISPATCH(const pixconv_impl_t *, &PIXCONV_SCALAR, &PIXCONV_SSE2, &PIXCONV_AVX2);
+}
+
+// --- specialized pairs ----------------------------------------------------
+
+static void rgb565_from_rgb888(PIXCONV_ROW_ARGS) {
+    uint16_t *d = (uint16_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    const pixconv_impl_t *impl = pixconv_impl();
+    size_t i = 0;
+    if (impl->rgb565_from_rgb888) impl->rgb565_from_rgb888(d, s, n, &i);
+    for (s += 3 * i; i < n; i++, s += 3)
+        d[i] = (uint16_t)(((s[0] & 0xF8) << 8) | ((s[1] & 0xFC) << 3) | (s[2] >> 3));
+}
+
+static void rgb888_from_rgb565(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint16_t *s = (const uint16_t *)src;
+    const pixconv_impl_t *impl = pixconv_impl();
+    size_t i = 0;
+    if (impl->rgb888_from_rgb565) impl->rgb888_from_rgb565(d, s, n, &i);
+    for (; i < n; i++) {
+        uint16_t p = s[i];
+        d[3 * i + 0] = (uint8_t)(((p >> 11) & 0x1F) << 3);
+        d[3 * i + 1] = (uint8_t)(((p >> 5) & 0x3F) << 2);
+        d[3 * i + 2] = (uint8_t)((p & 0x1F) << 3);
+    }
+}
+
+static void gray8_from_rgb888(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    const pixconv_impl_t *impl = pixconv_impl();
+    size_t i = 0;
+    if (impl->gray8_from_rgb888) impl->gray8_from_rgb888(d, s, n, &i);
+    for (s += 3 * i; i < n; i++, s += 3) d[i] = gray_of(lut, s[0], s[1], s[2]);
+}
+
+static void gray8_from_rgb565(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint16_t *s = (const uint16_t *)src;
+    const pixconv_impl_t *impl = pixconv_impl();
+    size_t i = 0;
+    if (impl->gray8_from_rgb565) impl->gray8_from_rgb565(d, s, n, &i);
+    for (; i < n; i++) {
+        uint16_t p = s[i];
+        d[i] = gray_of(lut, ((p >> 11) & 0x1F) << 3, ((p >> 5) & 0x3F) << 2, (p & 0x1F) << 3);
+    }
+}
+
+static void gray1_from_rgb888(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    const pixconv_impl_t *impl = pixconv_impl();
+    size_t i = 0;
+    if (impl->gray1_from_rgb888) impl->gray1_from_rgb888(d, s, n, &i);
+    for (; i < n; i += 8) {
+        size_t m = (n - i < 8) ? n - i : 8;
+        uint8_t gray[8];
+        gray8_from_rgb888(gray, s + 3 * i, m, lut);
+        gray1_from_gray8(d + (i >> 3), gray, m, lut);
+    }
+}
+
+static void gray1_from_rgb565(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint16_t *s = (const uint16_t *)src;
+    const pixconv_impl_t *impl = pixconv_impl();
+    size_t i = 0;
+    if (impl->gray1_from_rgb565) impl->gray1_from_rgb565(d, s, n, &i);
+    for (; i < n; i += 8) {
+        size_t m = (n - i < 8) ? n - i : 8;
+        uint8_t gray[8];
+        gray8_from_rgb565(gray, s + i, m, lut);
+        gray1_from_gray8(d + (i >> 3), gray, m, lut);
+    }
+}
+
+static void rgb565_from_f01(PIXCONV_ROW_ARGS) {
+    uint16_t *d = (uint16_t *)dst;
+    const float *s = (const float *)src;
+    for (size_t i = 0; i < n; i++, s += 3) {
+        uint8_t R = (uint8_t)(CLAMP01(s[0]) * 31 + 0.5f);
+        uint8_t G = (uint8_t)(CLAMP01(s[1]) * 63 + 0.5f);
+        uint8_t B = (uint8_t)(CLAMP01(s[2]) * 31 + 0.5f);
+        d[i] = (uint16_t)((R << 11) | (G << 5) | B);
+    }
+}
+
+static void f01_from_rgb565(PIXCONV_ROW_ARGS) {
+    float *d = (float *)dst;
+    const uint16_t *s = (const uint16_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        uint16_t p = s[i];
+        d[3 * i + 0] = ((p >> 11) & 0x1F) / 31.0f;
+        d[3 * i + 1] = ((p >> 5) & 0x3F) / 63.0f;
+        d[3 * i + 2] = (p & 0x1F) / 31.0f;
+    }
+}
+
+static void rgb888_from_f01(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const float *s = (const float *)src;
+    for (size_t i = 0; i < 3 * n; i++) d[i] = f01_to8(s[i]);
+}
+
+static void f01_from_rgb888(PIXCONV_ROW_ARGS) {
+    float *d = (float *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    for (size_t i = 0; i < 3 * n; i++) d[i] = s[i] / 255.0f;
+}
+
+static void rgb888_from_gray8(PIXCONV_ROW_ARGS) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    for (size_t i = 0; i < n; i++) d[3 * i] = d[3 * i + 1] = d[3 * i + 2] = s[i];
+}
+
+static void rgb565_from_gray8(PIXCONV_ROW_ARGS) {
+    uint16_t *d = (uint16_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        uint8_t g = s[i];
+        d[i] = (uint16_t)(((g & 0xF8) << 8) | ((g & 0xFC) << 3) | (g >> 3));
+    }
+}
+
+static const pixconv_row_t PIXCONV_TO_ARGB32[PIXFMT_COUNT] = {
+    [PIXFMT_ARGB32] = argb32_from_argb32,
+    [PIXFMT_RGBA32] = argb32_from_rgba32,
+    [PIXFMT_RGB565] = argb32_from_rgb565,
+    [PIXFMT_RGB888] = argb32_from_rgb888,
+    [PIXFMT_F01]    = argb32_from_f01,
+    [PIXFMT_GRAY8]  = argb32_from_gray8,
+    [PIXFMT_GRAY1]  = argb32_from_gray1
+};
+
+static const pixconv_row_t PIXCONV_FROM_ARGB32[PIXFMT_COUNT] = {
+    [PIXFMT_ARGB32] = argb32_from_argb32,
+    [PIXFMT_RGBA32] = rgba32_from_argb32,
+    [PIXFMT_RGB565] = rgb565_from_argb32,
+    [PIXFMT_RGB888] = rgb888_from_argb32,
+    [PIXFMT_F01]    = f01_from_argb32,
+    [PIXFMT_GRAY8]  = gray8_from_argb32,
+    [PIXFMT_GRAY1]  = gray1_from_argb32
+};
+
+// [src][dst]; NULL means "go through ARGB32". The F01 <-> RGB565 pairs must be
+// direct, the 8-bit intermediate would round differently from f01_2rgb565/rgb565_2f01.
+static const pixconv_row_t PIXCONV_DIRECT[PIXFMT_COUNT][PIXFMT_COUNT] = {
+    [PIXFMT_ARGB32] = {
+        [PIXFMT_RGBA32] = rgba32_from_argb32,
+        [PIXFMT_RGB565] = rgb565_from_argb32,
+        [PIXFMT_RGB888] = rgb888_from_argb32,
+        [PIXFMT_F01]    = f01_from_argb32,
+        [PIXFMT_GRAY8]  = gray8_from_argb32,
+    },
+    [PIXFMT_RGBA32] = {
+        [PIXFMT_ARGB32] = argb32_from_rgba32,
+    },
+    [PIXFMT_RGB565] = {
+        [PIXFMT_ARGB32] = argb32_from_rgb565,
+        [PIXFMT_RGB888] = rgb888_from_rgb565,
+        [PIXFMT_F01]    = f01_from_rgb565,
+        [PIXFMT_GRAY8]  = gray8_from_rgb565,
+        [PIXFMT_GRAY1]  = gray1_from_rgb565,
+    },
+    [PIXFMT_RGB888] = {
+        [PIXFMT_ARGB32] = argb32_from_rgb888,
+        [PIXFMT_RGB565] = rgb565_from_rgb888,
+        [PIXFMT_F01]    = f01_from_rgb888,
+        [PIXFMT_GRAY8]  = gray8_from_rgb888,
+        [PIXFMT_GRAY1]  = gray1_from_rgb888,
+    },
+    [PIXFMT_F01] = {
+        [PIXFMT_ARGB32] = argb32_from_f01,
+        [PIXFMT_RGB565] = rgb565_from_f01,
+        [PIXFMT_RGB888] = rgb888_from_f01,
+    },
+    [PIXFMT_GRAY8] = {
+        [PIXFMT_ARGB32] = argb32_from_gray8,
+        [PIXFMT_RGB565] = rgb565_from_gray8,
+        [PIXFMT_RGB888] = rgb888_from_gray8,
+        [PIXFMT_GRAY1]  = gray1_from_gray8,
+    },
+    [PIXFMT_GRAY1] = {
+        [PIXFMT_ARGB32] = argb32_from_gray1,
+    },
+};
+
+static inline size_t pixfmt_offset(pixfmt_t fmt, size_t x) {
+    return (fmt == PIXFMT_GRAY1) ? (x >> 3) : x * (PIXFMT_BITS[fmt] >> 3);
+}
+
+static size_t __p_I_x_F_m_T_r_O_w_B_y_T_e_S__(pixfmt_t fmt, size_t width) {
+    if ((unsigned)fmt >= PIXFMT_COUNT) return 0;
+    return (fmt == PIXFMT_GRAY1) ? (width + 7) >> 3 : width * (PIXFMT_BITS[fmt] >> 3);
+}
+
+static void pixconv_generic_row(void *dst, pixfmt_t dst_fmt, const void *src, pixfmt_t src_fmt, size_t width,
+                                const pixconv_gray_t *lut) {
+    ARGB32_t tmp[PIXCONV_CHUNK];
+    for (size_t x = 0; x < width; x += PIXCONV_CHUNK) {
+        size_t n = (width - x < PIXCONV_CHUNK) ? width - x : PIXCONV_CHUNK;
+        PIXCONV_TO_ARGB32[src_fmt](tmp, (const uint8_t *)src + pixfmt_offset(src_fmt, x), n, lut);
+        PIXCONV_FROM_ARGB32[dst_fmt]((uint8_t *)dst + pixfmt_offset(dst_fmt, x), tmp, n, lut);
+    }
+}
+
+static int pixconv_image(void *dst, pixfmt_t dst_fmt, size_t dst_stride,
+                         const void *src, pixfmt_t src_fmt, size_t src_stride,
+                         size_t width, size_t height) {
+    if (!dst || !src) return -1;
+    if ((unsigned)dst_fmt >= PIXFMT_COUNT || (unsigned)src_fmt >= PIXFMT_COUNT) return -1;
+    if (width == 0 || height == 0) return 0;
+
+    size_t dst_row = __p_I_x_F_m_T_r_O_w_B_y_T_e_S__(dst_fmt, width);
+    size_t src_row = __p_I_x_F_m_T_r_O_w_B_y_T_e_S__(src_fmt, width);
+    if (dst_stride == 0) dst_stride = dst_row;
+    if (src_stride == 0) src_stride = src_row;
+    if (dst_stride < dst_row || src_stride < src_row) return -1;
+
+    const uint8_t *s = (const uint8_t *)src;
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s_end = s + src_stride * (height - 1) + src_row;
+    const uint8_t *d_end = d + dst_stride * (height - 1) + dst_row;
+
+    // Overlap is only supported for true in-place conversion that does not
+    // grow: each row then writes no further than it has already read.
+    if (d < s_end && s < d_end) {
+        if (d != s || PIXFMT_BITS[dst_fmt] > PIXFMT_BITS[src_fmt] || dst_stride > src_stride) return -1;
+    }
+
+    if (dst_fmt == src_fmt) {
+        if (d == s && dst_stride == src_stride) return 0;
+        for (size_t y = 0; y < height; y++) memmove(d + y * dst_stride, s + y * src_stride, src_row);
+        return 0;
+    }
+
+    // Fold padding-free images into a single long row (not for bit-packed rows).
+    if (dst_stride == dst_row && src_stride == src_row &&
+        dst_fmt != PIXFMT_GRAY1 && src_fmt != PIXFMT_GRAY1) {
+        width *= height;
+        height = 1;
+    }
+
+    pixconv_gray_t lut;
+    if ((dst_fmt == PIXFMT_GRAY8 || dst_fmt == PIXFMT_GRAY1) && src_fmt != PIXFMT_GRAY8)
+        gray_lut_init(&lut);
+
+    pixconv_row_t direct = PIXCONV_DIRECT[src_fmt][dst_fmt];
+    for (size_t y = 0; y < height; y++) {
+        if (direct) direct(d + y * dst_stride, s + y * src_stride, width, &lut);
+        else pixconv_generic_row(d + y * dst_stride, dst_fmt, s + y * src_stride, src_fmt, width, &lut);
+    }
+    return 0;
+}
+
+static int __p_I_x_C_o_N_v__(void *dst, pixfmt_t dst_fmt, size_t dst_stride,
+                             const void *src, pixfmt_t src_fmt, size_t src_stride,
+                             size_t width, size_t height) {
+    STAT_SCOPE_BEGIN(scope);
+    int ret = pixconv_image(dst, dst_fmt, dst_stride, src, src_fmt, src_stride, width, height);
+    STAT_SCOPE_END(scope, STAT_PIXCONV, (ret == 0) ? __p_I_x_F_m_T_r_O_w_B_y_T_e_S__(dst_fmt, width) * height : 0);
+    return ret;
+}
+
+
+__attribute__((weak, alias("__p_I_x_F_m_T_r_O_w_B_y_T_e_S__"))) size_t pixfmtRowBytes(pixfmt_t fmt, size_t width);
+__attribute__((weak, alias("__p_I_x_C_o_N_v__")))
+int pixconv(void *dst, pixfmt_t dst_fmt, size_t dst_stride,
+            const void *src, pixfmt_t src_fmt, size_t src_stride,
+            size_t width, size_t height);
@@ -51,15 +51,11 @@ static void __r_G_b_2_h_S_l__(float r, float g, float b, float *h, float *s, flo
 }
 
 static uint16_t __r_G_b_8_8_8_2_r_G_b_5_6_5__(uint8_t r, uint8_t g, uint8_t b) {
-    return ((r & 0xF8) << 8) |
-           ((g & 0xFC) << 3) |
-           (b >> 3);
+    return rgb888_2rgb565_inline(r, g, b);
 }
 
 static void __r_G_b_5_6_5_2_r_G_b_8_8_8__(uint16_t rgb565, uint8_t* r, uint8_t* g, uint8_t* b) {
-    *r = ((rgb565 >> 11) & 0x1F) << 3;
-    *g = ((rgb565 >> 5)  & 0x3F) << 2;
-    *b = (rgb565 & 0x1F) << 3;
+    rgb565_2rgb888_inline(rgb565, r, g, b);
 }
 
 
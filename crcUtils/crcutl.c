@@ -0,0 +1,152 @@
+/*
+ * File:        crcUtils/crcutl.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Slicing-by-8 CRC engines (see crcutl.h).
+ *
+ *    Reflected CRCs keep the register right-aligned and shift right;
+ *    non-reflected ones keep it left-aligned in 32 bits and shift left, so
+ *    any width from 8 to 32 uses the same 32-bit tables and loops. Eight
+ *    bytes go through eight independent table lookups per step instead of
+ *    a serial chain of eight.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "crcutl.h"
+
+static const struct {
+    uint8_t width;
+    uint32_t poly, init;
+    bool refin, refout;
+    uint32_t xorout;
+} CRC_PRESETS[CRC_PRESET_COUNT] = {
+    [CRC16_CCITT_FALSE] = { 16, 0x1021,     0xFFFF,     false, false, 0x0000 },
+    [CRC16_XMODEM]      = { 16, 0x1021,     0x0000,     false, false, 0x0000 },
+    [CRC16_KERMIT]      = { 16, 0x1021,     0x0000,     true,  true,  0x0000 },
+    [CRC16_X25]         = { 16, 0x1021,     0xFFFF,     true,  true,  0xFFFF },
+    [CRC16_MODBUS]      = { 16, 0x8005,     0xFFFF,     true,  true,  0x0000 },
+    [CRC32]             = { 32, 0x04C11DB7, 0xFFFFFFFF, true,  true,  0xFFFFFFFF },
+    [CRC32C]            = { 32, 0x1EDC6F41, 0xFFFFFFFF, true,  true,  0xFFFFFFFF },
+    [CRC32_MPEG2]       = { 32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000 },
+};
+
+static inline uint32_t crc_mask(uint8_t width) {
+    return (width == 32) ? 0xFFFFFFFFu : ((1u << width) - 1);
+}
+
+static uint32_t crc_reflect(uint32_t v, uint8_t width) {
+    uint32_t r = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        r = (r << 1) | (v & 1);
+        v >>= 1;
+    }
+    return r;
+}
+
+static inline uint32_t load32le(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline uint32_t load32be(const uint8_t *p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+}
+
+static int __c_R_c_I_n_I_t__(crc_t *crc, uint8_t width, uint32_t poly, uint32_t init,
+                             bool refin, bool refout, uint32_t xorout) {
+    if (!crc || width < 8 || width > 32) return -1;
+    crc->width = width;
+    crc->refin = refin;
+    crc->refout = refout;
+    crc->poly = poly & crc_mask(width);
+    crc->init = init & crc_mask(width);
+    crc->xorout = xorout & crc_mask(width);
+
+    if (refin) {
+        uint32_t rpoly = crc_reflect(crc->poly, width);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? (c >> 1) ^ rpoly : c >> 1;
+            crc->table[0][i] = c;
+        }
+        for (int t = 1; t < 8; t++) {
+            for (int i = 0; i < 256; i++) {
+                uint32_t c = crc->table[t - 1][i];
+                crc->table[t][i] = (c >> 8) ^ crc->table[0][c & 0xFF];
+            }
+        }
+    } else {
+        uint32_t lpoly = crc->poly << (32 - width);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i << 24;
+            for (int k = 0; k < 8; k++) c = (c & 0x80000000u) ? (c << 1) ^ lpoly : c << 1;
+            crc->table[0][i] = c;
+        }
+        for (int t = 1; t < 8; t++) {
+            for (int i = 0; i < 256; i++) {
+                uint32_t c = crc->table[t - 1][i];
+                crc->table[t][i] = (c << 8) ^ crc->table[0][c >> 24];
+            }
+        }
+    }
+    return 0;
+}
+
+static int __c_R_c_I_n_I_t_P_r_E_s_E_t__(crc_t *crc, crc_preset_t preset) {
+    if ((unsigned)preset >= CRC_PRESET_COUNT) return -1;
+    return __c_R_c_I_n_I_t__(crc, CRC_PRESETS[preset].width, CRC_PRESETS[preset].poly, CRC_PRESETS[preset].init,
+                             CRC_PRESETS[preset].refin, CRC_PRESETS[preset].refout, CRC_PRESETS[preset].xorout);
+}
+
+static uint32_t __c_R_c_B_e_G_i_N__(const crc_t *crc) {
+    return crc->refin ? crc_reflect(crc->init, crc->width) : crc->init << (32 - crc->width);
+}
+
+static uint32_t __c_R_c_U_p_D_a_T_e__(const crc_t *crc, uint32_t reg, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    const uint32_t (*T)[256] = crc->table;
+    if (!p) return reg;
+
+    if (crc->refin) {
+        for (; len >= 8; len -= 8, p += 8) {
+            uint32_t lo = reg ^ load32le(p);
+            uint32_t hi = load32le(p + 4);
+            reg = T[7][lo & 0xFF] ^ T[6][(lo >> 8) & 0xFF] ^ T[5][(lo >> 16) & 0xFF] ^ T[4][lo >> 24] ^
+                  T[3][hi & 0xFF] ^ T[2][(hi >> 8) & 0xFF] ^ T[1][(hi >> 16) & 0xFF] ^ T[0][hi >> 24];
+        }
+        for (; len; len--, p++) reg = (reg >> 8) ^ T[0][(reg ^ *p) & 0xFF];
+    } else {
+        for (; len >= 8; len -= 8, p += 8) {
+            uint32_t hi = reg ^ load32be(p);
+            uint32_t lo = load32be(p + 4);
+            reg = T[7][hi >> 24] ^ T[6][(hi >> 16) & 0xFF] ^ T[5][(hi >> 8) & 0xFF] ^ T[4][hi & 0xFF] ^
+                  T[3][lo >> 24] ^ T[2][(lo >> 16) & 0xFF] ^ T[1][(lo >> 8) & 0xFF] ^ T[0][lo & 0xFF];
+        }
+        for (; len; len--, p++) reg = (reg << 8) ^ T[0][(reg >> 24) ^ *p];
+    }
+    return reg;
+}
+
+static uint32_t __c_R_c_F_i_N_a_L__(const crc_t *crc, uint32_t reg) {
+    uint32_t v = crc->refin ? reg : reg >> (32 - crc->width);
+    if (crc->refin != crc->refout) v = crc_reflect(v, crc->width);
+    return (v ^ crc->xorout) & crc_mask(crc->width);
+}
+
+static uint32_t __c_R_c_C_o_M_p_U_t_E__(const crc_t *crc, const void *data, size_t len) {
+    return __c_R_c_F_i_N_a_L__(crc, __c_R_c_U_p_D_a_T_e__(crc, __c_R_c_B_e_G_i_N__(crc), data, len));
+}
+
+
+__attribute__((weak, alias("__c_R_c_I_n_I_t__")))
+int crcInit(crc_t *crc, uint8_t width, uint32_t poly, uint32_t init, bool refin, bool refout, uint32_t xorout);
+__attribute__((weak, alias("__c_R_c_I_n_I_t_P_r_E_s_E_t__"))) int crcInitPreset(crc_t *crc, crc_preset_t preset);
+__attribute__((weak, alias("__c_R_c_B_e_G_i_N__"))) uint32_t crcBegin(const crc_t *crc);
+__attribute__((weak, alias("__c_R_c_U_p_D_a_T_e__"))) uint32_t crcUpdate(const crc_t *crc, uint32_t reg, const void *data, size_t len);
+__attribute__((weak, alias("__c_R_c_F_i_N_a_L__"))) uint32_t crcFinal(const crc_t *crc, uint32_t reg);
+__attribute__((weak, alias("__c_R_c_C_o_M_p_U_t_E__"))) uint32_t crcCompute(const crc_t *crc, const void *data, size_t len);
@@ -0,0 +1,64 @@
+/*
+ * File:        crcUtils/crcutl.h
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    header (function define) for crcutl.c
+ *
+ *    Table-driven CRC engines for 8..32-bit CRCs in the usual parametric
+ *    form (width, poly, init, refin, refout, xorout). crcInit() builds
+ *    slicing-by-8 tables, so crcUpdate() consumes 8 bytes per step. The
+ *    register can be carried across calls to checksum data that arrives in
+ *    pieces.
+ */
+
+#ifndef CRCUTL_H
+#define CRCUTL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum {
+    CRC16_CCITT_FALSE = 0,  // poly 0x1021, init 0xFFFF
+    CRC16_XMODEM,           // poly 0x1021, init 0x0000
+    CRC16_KERMIT,           // poly 0x1021 reflected, init 0x0000
+    CRC16_X25,              // poly 0x1021 reflected, init / xorout 0xFFFF (HDLC FCS)
+    CRC16_MODBUS,           // poly 0x8005 reflected, init 0xFFFF
+    CRC32,                  // poly 0x04C11DB7 reflected (Ethernet, zlib)
+    CRC32C,                 // poly 0x1EDC6F41 reflected (Castagnoli)
+    CRC32_MPEG2,            // poly 0x04C11DB7, init 0xFFFFFFFF, no xorout
+    CRC_PRESET_COUNT
+} crc_preset_t;
+
+// Engine state; the tables make it about 8 KiB, so build it once and share it.
+typedef struct {
+    uint8_t width;          // 8..32
+    bool refin, refout;
+    uint32_t poly;          // normal (MSB-first) form, width bits
+    uint32_t init;
+    uint32_t xorout;
+    uint32_t table[8][256]; // slicing-by-8; register kept reflected (refin) or left-aligned
+} crc_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns -1 for a width outside 8..32 or an unknown preset.
+int crcInit(crc_t *crc, uint8_t width, uint32_t poly, uint32_t init, bool refin, bool refout, uint32_t xorout);
+int crcInitPreset(crc_t *crc, crc_preset_t preset);
+
+// Incremental use: reg = crcBegin(); reg = crcUpdate(..., reg, ...) per piece; crcFinal(reg).
+uint32_t crcBegin(const crc_t *crc);
+uint32_t crcUpdate(const crc_t *crc, uint32_t reg, const void *data, size_t len);
+uint32_t crcFinal(const crc_t *crc, uint32_t reg);
+uint32_t crcCompute(const crc_t *crc, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRCUTL_H
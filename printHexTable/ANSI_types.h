@@ -32,14 +32,14 @@ typedef struct{
     ANSI_ErrLevel_t errLevel[256];
 } ANSIErrTagMap256_t;
 
-static const char* ANSI_LEVEL_COLOR[4] = {
+static const char* const ANSI_LEVEL_COLOR[4] = {
     "\e[0m",        // NML
     "\e[38;5;33m",  // DBG - fg Blue, bg NL
     "\e[38;5;226m", // WAN - fg Yellow, bg NL
     "\e[38;5;196m"  // ERR - fg Red, bg NL
 };
 
-static const char* ANSI_LEVEL_COLOR_BG[4] = {
+static const char* const ANSI_LEVEL_COLOR_BG[4] = {
     "\e[0m",                      // NML
     "\e[48;5;33m",                // DBG - bg Blue, fg NL
     "\e[48;5;226m\e[38;5;16m",    // WAN - bg Yellow, fg BLACK
@@ -0,0 +1,375 @@
+/*
+ * File:        printHexTable/hexcache.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Bounded LRU cache of rendered hex tables, for traffic that repeats
+ *    byte-for-byte (beacons, ACKs, routing updates).
+ *
+ *    Entries are keyed by everything the renderer reads: the first 256
+ *    bytes and the length, both maps (colour strings by content), title,
+ *    tail and table kind. The key is serialised and kept in the entry, so a
+ *    64-bit hash collision is a miss, never the wrong table. Lookups hold
+ *    the read lock only to find the entry, take a reference and move it to
+ *    the front of the LRU list (under a short mutex); the copy or fwrite()
+ *    happens after the lock is released, so a slow stream never holds up
+ *    inserts. Inserts and evictions take the write lock and evict from the
+ *    tail of the LRU list until the new entry fits in the byte budget.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "printHexTable.h"
+#include <printfUtils/printfutl.h>
+
+#define HASH_P1 0x9E3779B185EBCA87ull
+#define HASH_P2 0xC2B2AE3D27D4EB4Full
+#define HASH_P3 0x165667B19E3779F9ull
+
+typedef struct hex_cache_entry {
+    struct hex_cache_entry *next;       // bucket chain
+    struct hex_cache_entry *newer, *older;  // LRU list
+    uint64_t hash;
+    unsigned refs;                      // the cache's own plus readers copying out
+    size_t keyLen;
+    size_t len;
+    char data[];                        // table, '\0', then the key bytes
+} hex_cache_entry_t;
+
+struct HexCache {
+    pthread_rwlock_t lock;
+    pthread_mutex_t lruLock;            // LRU moves by readers under the read lock
+    hex_cache_entry_t **bucket;
+    size_t nbucket;                     // power of two
+    hex_cache_entry_t *newest, *oldest;
+    size_t maxBytes;
+    size_t bytes;
+    size_t entries;
+    uint64_t hits, misses, evictions;
+};
+
+typedef enum {
+    HEXCACHE_PLAIN = 1,
+    HEXCACHE_COLOR = 2
+} hex_cache_kind_t;
+
+// Serialised render inputs; key_put() counts past cap so the caller can retry
+// with a bigger buffer.
+typedef struct {
+    uint8_t *buf;
+    size_t cap;
+    size_t len;
+} hex_cache_key_t;
+
+#define HEXCACHE_KEY_STACK 2048
+
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hash_word(uint64_t h, uint64_t w) {
+    return rotl64(h ^ (w * HASH_P2), 31) * HASH_P1;
+}
+
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = hash_word(h, w);
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, p, len);
+    return hash_word(h, tail ^ ((uint64_t)len << 56));
+}
+
+static inline uint64_t hash_final(uint64_t h) {
+    h ^= h >> 33;
+    h *= HASH_P2;
+    h ^= h >> 29;
+    h *= HASH_P3;
+    return h ^ (h >> 32);
+}
+
+static void key_put(hex_cache_key_t *k, const void *data, size_t n) {
+    if (k->len + n <= k->cap) memcpy(k->buf + k->len, data, n);
+    k->len += n;
+}
+
+static void key_put_str(hex_cache_key_t *k, const char *s) {
+    uint32_t len = s ? (uint32_t)strlen(s) : UINT32_MAX;
+    key_put(k, &len, sizeof(len));
+    if (s) key_put(k, s, len);
+}
+
+// Everything the renderer reads: the first 256 bytes and the length, both
+// maps (colour strings by content), title, tail and table kind.
+static void render_key(hex_cache_key_t *k, hex_cache_kind_t kind, const uint8_t *buffer, size_t buffer_len,
+                       const ANSIColorMap256_t *ansiMap, const ANSIErrTagMap256_t *errMap,
+                       const char *title_str, const char *tail_str) {
+    uint8_t flags = (uint8_t)(kind | (ansiMap ? 4 : 0) | (errMap ? 8 : 0));
+    key_put(k, &flags, 1);
+    key_put(k, &buffer_len, sizeof(buffer_len));
+    key_put(k, buffer, (buffer_len > 256) ? 256 : buffer_len);
+    if (ansiMap) {
+        key_put(k, ansiMap->charBegin, sizeof(ansiMap->charBegin));
+        key_put(k, ansiMap->charEnd, sizeof(ansiMap->charEnd));
+        // One string per run of equal colours.
+        const char *prev = NULL;
+        for (int i = 0; i < 256; i++) {
+            const char *s = ansiMap->ansiColorStr[i];
+            if (i && (s == prev || (s && prev && strcmp(s, prev) == 0))) continue;
+            uint8_t at = (uint8_t)i;
+            key_put(k, &at, 1);
+            key_put_str(k, s);
+            prev = s;
+        }
+    }
+    if (errMap) {
+        uint8_t level[256];
+        for (int i = 0; i < 256; i++) level[i] = (uint8_t)errMap->errLevel[i];
+        key_put(k, level, sizeof(level));
+    }
+    key_put_str(k, title_str);
+    key_put_str(k, tail_str);
+}
+
+static inline size_t entry_cost(size_t len, size_t keyLen) {
+    return sizeof(hex_cache_entry_t) + len + 1 + keyLen;
+}
+
+// Caller holds the lock (read or write).
+static hex_cache_entry_t *cache_find(const HexCache_t *c, uint64_t hash, const hex_cache_key_t *k) {
+    for (hex_cache_entry_t *e = c->bucket[hash & (c->nbucket - 1)]; e; e = e->next) {
+        if (e->hash == hash && e->keyLen == k->len && memcmp(e->data + e->len + 1, k->buf, k->len) == 0) return e;
+    }
+    return NULL;
+}
+
+// Caller holds the write lock, or the read lock and lruLock.
+static void lru_unlink(HexCache_t *c, hex_cache_entry_t *e) {
+    if (e->newer) e->newer->older = e->older;
+    else c->newest = e->older;
+    if (e->older) e->older->newer = e->newer;
+    else c->oldest = e->newer;
+}
+
+static void lru_push(HexCache_t *c, hex_cache_entry_t *e) {
+    e->newer = NULL;
+    e->older = c->newest;
+    if (c->newest) c->newest->newer = e;
+    else c->oldest = e;
+    c->newest = e;
+}
+
+static void entry_release(hex_cache_entry_t *e) {
+    if (__atomic_sub_fetch(&e->refs, 1, __ATOMIC_ACQ_REL) == 0) free(e);
+}
+
+// Caller holds the write lock. Readers still copying the entry keep it alive.
+static void cache_remove(HexCache_t *c, hex_cache_entry_t *e) {
+    hex_cache_entry_t **link = &c->bucket[e->hash & (c->nbucket - 1)];
+    while (*link != e) link = &(*link)->next;
+    *link = e->next;
+    lru_unlink(c, e);
+    c->bytes -= entry_cost(e->len, e->keyLen);
+    c->entries--;
+    entry_release(e);
+}
+
+static void cache_insert(HexCache_t *c, uint64_t hash, const hex_cache_key_t *k, const char *out) {
+    size_t len = strlen(out);
+    size_t cost = entry_cost(len, k->len);
+    if (cost > c->maxBytes) return;
+    // Cache memory is shared between threads, so it never comes from a thread's allocator.
+    hex_cache_entry_t *e = (hex_cache_entry_t *)malloc(cost);
+    if (!e) return;
+    e->hash = hash;
+    e->refs = 1;
+    e->keyLen = k->len;
+    e->len = len;
+    memcpy(e->data, out, len + 1);
+    memcpy(e->data + len + 1, k->buf, k->len);
+
+    pthread_rwlock_wrlock(&c->lock);
+    if (cache_find(c, hash, k)) {
+        // Another thread rendered the same frame first.
+        pthread_rwlock_unlock(&c->lock);
+        free(e);
+        return;
+    }
+    while (c->oldest && c->bytes + cost > c->maxBytes) {
+        cache_remove(c, c->oldest);
+        __atomic_add_fetch(&c->evictions, 1, __ATOMIC_RELAXED);
+    }
+    hex_cache_entry_t **head = &c->bucket[hash & (c->nbucket - 1)];
+    e->next = *head;
+    *head = e;
+    lru_push(c, e);
+    c->bytes += cost;
+    c->entries++;
+    pthread_rwlock_unlock(&c->lock);
+}
+
+static char *render(hex_cache_kind_t kind, uint8_t *buffer, size_t buffer_len,
+                    ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap,
+                    const char *title_str, const char *tail_str) {
+    if (kind == HEXCACHE_COLOR) return printColorHexTable256(buffer, buffer_len, ansiMap, errMap, title_str, tail_str);
+    return printHexTable256(buffer, buffer_len, title_str, tail_str);
+}
+
+// Returns a utlAlloc() copy of the table; with out set, writes it there instead,
+// stores the length (or -1) in *written and returns NULL.
+static char *cache_lookup(HexCache_t *c, hex_cache_kind_t kind, FILE *out, long *written,
+                          uint8_t *buffer, size_t buffer_len,
+                          ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap,
+                          const char *title_str, const char *tail_str) {
+    if (!buffer) return NULL;
+    uint8_t stackKey[HEXCACHE_KEY_STACK];
+    hex_cache_key_t k = { stackKey, sizeof(stackKey), 0 };
+    uint64_t hash = 0;
+    if (c) {
+        render_key(&k, kind, buffer, buffer_len, ansiMap, errMap, title_str, tail_str);
+        if (k.len > k.cap) {
+            // Long colour strings: build the key again on the heap.
+            k = (hex_cache_key_t){ (uint8_t *)malloc(k.len), k.len, 0 };
+            if (k.buf) render_key(&k, kind, buffer, buffer_len, ansiMap, errMap, title_str, tail_str);
+            else c = NULL;
+        }
+    }
+    if (c) {
+        hash = hash_final(hash_bytes(HASH_P3, k.buf, k.len));
+        pthread_rwlock_rdlock(&c->lock);
+        hex_cache_entry_t *e = cache_find(c, hash, &k);
+        if (e) {
+            __atomic_add_fetch(&e->refs, 1, __ATOMIC_RELAXED);
+            pthread_mutex_lock(&c->lruLock);
+            if (c->newest != e) {
+                lru_unlink(c, e);
+                lru_push(c, e);
+            }
+            pthread_mutex_unlock(&c->lruLock);
+        }
+        pthread_rwlock_unlock(&c->lock);
+        if (e) {
+            // Our reference keeps the entry valid even if it is evicted meanwhile.
+            __atomic_add_fetch(&c->hits, 1, __ATOMIC_RELAXED);
+            char *copy = NULL;
+            if (out) {
+                *written = (fwrite(e->data, 1, e->len, out) == e->len) ? (long)e->len : -1;
+            } else if ((copy = (char *)utlAlloc(e->len + 1))) {
+                memcpy(copy, e->data, e->len + 1);
+            }
+            entry_release(e);
+            if (k.buf != stackKey) free(k.buf);
+            return copy;
+        }
+        __atomic_add_fetch(&c->misses, 1, __ATOMIC_RELAXED);
+    }
+
+    char *s = render(kind, buffer, buffer_len, ansiMap, errMap, title_str, tail_str);
+    if (s && c) cache_insert(c, hash, &k, s);
+    if (k.buf != stackKey) free(k.buf);
+    if (!s) return NULL;
+    if (out) {
+        size_t len = strlen(s);
+        *written = (fwrite(s, 1, len, out) == len) ? (long)len : -1;
+        utlFree(s);
+        return NULL;
+    }
+    return s;
+}
+
+
+static HexCache_t *__h_E_x_C_a_C_h_E_n_E_w__(size_t maxBytes) {
+    HexCache_t *c = (HexCache_t *)calloc(1, sizeof(*c));
+    if (!c) return NULL;
+    // Roughly one bucket per 4 KiB of budget (a coloured table is 8-12 KiB).
+    size_t nbucket = 16;
+    while (nbucket < maxBytes / 4096 && nbucket < ((size_t)1 << 20)) nbucket <<= 1;
+    c->bucket = (hex_cache_entry_t **)calloc(nbucket, sizeof(*c->bucket));
+    if (!c->bucket || pthread_rwlock_init(&c->lock, NULL) != 0) {
+        free(c->bucket);
+        free(c);
+        return NULL;
+    }
+    pthread_mutex_init(&c->lruLock, NULL);
+    c->nbucket = nbucket;
+    c->maxBytes = maxBytes;
+    return c;
+}
+
+static void __h_E_x_C_a_C_h_E_c_L_e_A_r__(HexCache_t *c) {
+    if (!c) return;
+    pthread_rwlock_wrlock(&c->lock);
+    while (c->oldest) cache_remove(c, c->oldest);
+    pthread_rwlock_unlock(&c->lock);
+}
+
+static void __h_E_x_C_a_C_h_E_f_R_e_E__(HexCache_t *c) {
+    if (!c) return;
+    __h_E_x_C_a_C_h_E_c_L_e_A_r__(c);
+    pthread_rwlock_destroy(&c->lock);
+    pthread_mutex_destroy(&c->lruLock);
+    free(c->bucket);
+    free(c);
+}
+
+static void __h_E_x_C_a_C_h_E_s_T_a_T_s__(HexCache_t *c, HexCacheStats_t *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!c) return;
+    pthread_rwlock_rdlock(&c->lock);
+    out->hits = __atomic_load_n(&c->hits, __ATOMIC_RELAXED);
+    out->misses = __atomic_load_n(&c->misses, __ATOMIC_RELAXED);
+    out->evictions = __atomic_load_n(&c->evictions, __ATOMIC_RELAXED);
+    out->entries = c->entries;
+    out->bytes = c->bytes;
+    out->maxBytes = c->maxBytes;
+    pthread_rwlock_unlock(&c->lock);
+}
+
+static char *__h_E_x_C_a_C_h_E_t_A_b_L_e_2_5_6__(HexCache_t *c, uint8_t *buffer, size_t buffer_len,
+                                                 const char *title_str, const char *tail_str) {
+    return cache_lookup(c, HEXCACHE_PLAIN, NULL, NULL, buffer, buffer_len, NULL, NULL, title_str, tail_str);
+}
+
+static char *__h_E_x_C_a_C_h_E_c_O_l_O_r_T_a_B_l_E_2_5_6__(HexCache_t *c, uint8_t *buffer, size_t buffer_len,
+                                                           ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap,
+                                                           const char *title_str, const char *tail_str) {
+    return cache_lookup(c, HEXCACHE_COLOR, NULL, NULL, buffer, buffer_len, ansiMap, errMap, title_str, tail_str);
+}
+
+static long __h_E_x_C_a_C_h_E_f_P_u_T_c_O_l_O_r_T_a_B_l_E_2_5_6__(HexCache_t *c, FILE *out,
+                                                                  uint8_t *buffer, size_t buffer_len,
+                                                                  ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap,
+                                                                  const char *title_str, const char *tail_str) {
+    long written = -1;
+    if (!out) return -1;
+    cache_lookup(c, HEXCACHE_COLOR, out, &written, buffer, buffer_len, ansiMap, errMap, title_str, tail_str);
+    return written;
+}
+
+
+__attribute__((weak, alias("__h_E_x_C_a_C_h_E_n_E_w__"))) HexCache_t *hexCacheNew(size_t maxBytes);
+__attribute__((weak, alias("__h_E_x_C_a_C_h_E_f_R_e_E__"))) void hexCacheFree(HexCache_t *cache);
+__attribute__((weak, alias("__h_E_x_C_a_C_h_E_c_L_e_A_r__"))) void hexCacheClear(HexCache_t *cache);
+__attribute__((weak, alias("__h_E_x_C_a_C_h_E_s_T_a_T_s__"))) void hexCacheStats(HexCache_t *cache, HexCacheStats_t *out);
+__attribute__((weak, alias("__h_E_x_C_a_C_h_E_t_A_b_L_e_2_5_6__")))
+char* hexCacheTable256(HexCache_t *cache, uint8_t *buffer, size_t buffer_len, const char *title_str, const char *tail_str);
+__attribute__((weak, alias("__h_E_x_C_a_C_h_E_c_O_l_O_r_T_a_B_l_E_2_5_6__")))
+char* hexCacheColorTable256(HexCache_t *cache, uint8_t *buffer, size_t buffer_len, ANSIColorMap256_t *ansiMap,
+                            ANSIErrTagMap256_t *errMap, const char *title_str, const char *tail_str);
+__attribute__((weak, alias("__h_E_x_C_a_C_h_E_f_P_u_T_c_O_l_O_r_T_a_B_l_E_2_5_6__")))
+long hexCacheFputColorTable256(HexCache_t *cache, FILE *out, uint8_t *buffer, size_t buffer_len,
+                               ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap,
+                               const char *title_str, const char *tail_str);
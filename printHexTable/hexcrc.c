@@ -0,0 +1,93 @@
+/*
+ * File:        printHexTable/hexcrc.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    CRC check pre-pass for the hex tables: verifies a frame's CRC trailer
+ *    with a crcUtils engine and, when it does not match, tags the trailer
+ *    ERR and the covered region WAN in the error map. Segmented frames are
+ *    checked in place, piece by piece.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "printHexTable.h"
+
+// Feed bytes [begin, begin + len) of the segmented frame into the CRC register.
+static uint32_t crc_segments(const crc_t *crc, uint32_t reg, const HexSeg_t *segs, size_t nsegs,
+                             size_t begin, size_t len) {
+    size_t base = 0;
+    size_t end = begin + len;
+    for (size_t i = 0; i < nsegs && base < end; i++) {
+        size_t seg_end = base + segs[i].len;
+        if (seg_end > begin) {
+            size_t from = (begin > base) ? begin - base : 0;
+            size_t to = (end < seg_end) ? end - base : segs[i].len;
+            reg = crcUpdate(crc, reg, segs[i].ptr + from, to - from);
+        }
+        base = seg_end;
+    }
+    return reg;
+}
+
+static uint8_t segments_byte(const HexSeg_t *segs, size_t nsegs, size_t pos) {
+    for (size_t i = 0; i < nsegs; i++) {
+        if (pos < segs[i].len) return segs[i].ptr[pos];
+        pos -= segs[i].len;
+    }
+    return 0;
+}
+
+// Tag [begin, begin + len) at level, clipped to the 256-entry map.
+static void tag_clipped(ANSIErrTagMap256_t *errMap, size_t begin, size_t len, ANSI_ErrLevel_t level) {
+    if (!errMap || len == 0 || begin > 255) return;
+    size_t last = begin + len - 1;
+    addr2AnsiErrTag256(errMap, (uint8_t)begin, (uint8_t)((last > 255) ? 255 : last), level);
+}
+
+static int __h_E_x_C_r_C_t_A_g_2_5_6_v__(const crc_t *crc, const HexSeg_t *segs, size_t nsegs,
+                                         size_t begin, size_t len, size_t trailer, bool bigEndian,
+                                         ANSIErrTagMap256_t *errMap) {
+    if (!crc || !segs) return -1;
+    size_t total = 0;
+    for (size_t i = 0; i < nsegs; i++) {
+        if (!segs[i].ptr && segs[i].len) return -1;
+        total += segs[i].len;
+    }
+    size_t nbytes = (crc->width + 7) / 8;
+    if (begin > total || len > total - begin || trailer > total || nbytes > total - trailer) return -1;
+
+    uint32_t calc = crcFinal(crc, crc_segments(crc, crcBegin(crc), segs, nsegs, begin, len));
+    uint32_t stored = 0;
+    for (size_t i = 0; i < nbytes; i++) {
+        uint32_t b = segments_byte(segs, nsegs, trailer + i);
+        stored |= bigEndian ? b << (8 * (nbytes - 1 - i)) : b << (8 * i);
+    }
+    if (crc->width < 32) stored &= (1u << crc->width) - 1;
+    if (stored == calc) return 1;
+
+    tag_clipped(errMap, begin, len, ANSI_ErrLevel_WAN);
+    tag_clipped(errMap, trailer, nbytes, ANSI_ErrLevel_ERR);
+    return 0;
+}
+
+static int __h_E_x_C_r_C_t_A_g_2_5_6__(const crc_t *crc, const uint8_t *buf, size_t buf_len,
+                                       size_t begin, size_t len, size_t trailer, bool bigEndian,
+                                       ANSIErrTagMap256_t *errMap) {
+    if (!buf) return -1;
+    HexSeg_t seg = { buf, buf_len };
+    return __h_E_x_C_r_C_t_A_g_2_5_6_v__(crc, &seg, 1, begin, len, trailer, bigEndian, errMap);
+}
+
+
+__attribute__((weak, alias("__h_E_x_C_r_C_t_A_g_2_5_6__")))
+int hexCrcTag256(const crc_t *crc, const uint8_t *buf, size_t buf_len, size_t begin, size_t len,
+                 size_t trailer, bool bigEndian, ANSIErrTagMap256_t *errMap);
+__attribute__((weak, alias("__h_E_x_C_r_C_t_A_g_2_5_6_v__")))
+int hexCrcTag256v(const crc_t *crc, const HexSeg_t *segs, size_t nsegs, size_t begin, size_t len,
+                  size_t trailer, bool bigEndian, ANSIErrTagMap256_t *errMap);
@@ -0,0 +1,534 @@
+/*
+ * File:        printHexTable/hexjournal.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Append-only binary journal of raw frames, for gateways that cannot
+ *    afford to render tables on the hot path. Each entry keeps the frame
+ *    bytes, a timestamp, a title and the annotations as sparse ranges; any
+ *    entry can be rendered later through the normal table renderers.
+ *
+ *    File layout (all integers little-endian):
+ *      "HEXJRNL\1"                                      8-byte file magic
+ *      records, each starting with a u32 size of the bytes that follow it:
+ *        string: u32 size, u8 type = 2, u32 id, u16 len, bytes
+ *        frame:  u32 size, u8 type = 1, u32 title id, u16 nranges,
+ *                u64 timestamp, u32 len,
+ *                nranges * { u8 begin, u8 end, u32 colour id, u8 level,
+ *                            char charBegin, char charEnd },
+ *                len frame bytes
+ *    Strings (titles, colour escapes) are interned per file: the first use
+ *    writes a string record and later entries refer to it by id (1, 2, ...
+ *    in file order, 0 = none). Records are assembled in a private buffer, so an append is
+ *    a few header stores plus one memcpy of the frame. Opening an existing
+ *    journal for append reloads its strings and cuts off a record torn at
+ *    the end of the file; any other malformed record fails the open and
+ *    leaves the file as it is.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "printHexTable.h"
+#include <statUtils/statutl.h>
+
+#define JOURNAL_MAGIC        "HEXJRNL\1"
+#define JOURNAL_MAGIC_LEN    8
+#define JOURNAL_REC_FRAME    1
+#define JOURNAL_REC_STRING   2
+#define JOURNAL_FRAME_HDR    23
+#define JOURNAL_STRING_HDR   11
+#define JOURNAL_RANGE_BYTES  9
+#define JOURNAL_BUF_BYTES    (64 * 1024)
+
+// Interned strings by id, [0] unused.
+typedef struct {
+    char **str;
+    uint32_t n, cap;
+} journal_strings_t;
+
+// Strings and frame offsets found by journal_scan().
+typedef struct {
+    journal_strings_t strs;
+    off_t *frames;                          // NULL: not collected
+    size_t nframes, cap;
+    bool collect;
+    off_t end;                              // end of the last complete record
+    off_t size;                             // file size when scanned
+} journal_scan_t;
+
+struct HexJournal {
+    FILE *fp;
+    uint8_t *buf;
+    size_t len, cap;
+    journal_strings_t strs;
+    uint32_t *slots;                        // open-addressed ids by string hash, 0 = empty
+    uint32_t nslots;                        // power of two, more than twice strs.n
+    uint32_t *ids;                          // colour ids of the append in progress
+    size_t idsCap;
+    bool failed;                            // a write failed; the tail of the file is unknown
+};
+
+struct HexJournalReader {
+    FILE *fp;
+    journal_scan_t scan;
+    uint8_t *rec;
+    size_t recCap;
+    HexJournalRange_t *ranges;
+    size_t rangeCap;
+    HexJournalEntry_t entry;
+};
+
+static inline void put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put32(uint8_t *p, uint32_t v) {
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint16_t get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static inline uint32_t get32(const uint8_t *p) {
+    return (uint32_t)get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+static void strings_free(journal_strings_t *t) {
+    for (uint32_t i = 1; i <= t->n; i++) free(t->str[i]);
+    free(t->str);
+}
+
+// Takes ownership of str as id t->n + 1; returns -1 when out of memory or ids.
+static int strings_push(journal_strings_t *t, char *str) {
+    if (t->n + 1 >= t->cap) {
+        if (t->cap > UINT32_MAX / 2) return -1;
+        uint32_t cap = t->cap ? t->cap * 2 : 64;
+        char **grown = (char **)realloc(t->str, cap * sizeof(*grown));
+        if (!grown) return -1;
+        t->str = grown;
+        t->cap = cap;
+    }
+    t->str[++t->n] = str;
+    return 0;
+}
+
+static uint32_t str_hash(const char *s) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    while (*s) h = (h ^ (uint8_t)*s++) * 16777619u;
+    return h;
+}
+
+// Checks the header fields of a record against its size prefix. avail is how
+// many header bytes the file holds; a torn last record may have only some, and
+// only those are checked. Returns -1 when anything present disagrees.
+static int journal_check_header(const uint8_t *hdr, size_t avail, uint32_t recLen, uint32_t nstrs) {
+    if (hdr[4] == JOURNAL_REC_STRING) {
+        if (recLen < JOURNAL_STRING_HDR - 4) return -1;
+        if (avail >= 9 && get32(hdr + 5) != nstrs + 1) return -1;
+        if (avail >= JOURNAL_STRING_HDR && recLen != (uint32_t)(JOURNAL_STRING_HDR - 4 + get16(hdr + 9))) return -1;
+    } else if (hdr[4] == JOURNAL_REC_FRAME) {
+        if (recLen < JOURNAL_FRAME_HDR - 4) return -1;
+        if (avail >= 9 && get32(hdr + 5) > nstrs) return -1;
+        if (avail >= JOURNAL_FRAME_HDR &&
+            (uint64_t)get16(hdr + 9) * JOURNAL_RANGE_BYTES + get32(hdr + 19) != recLen - (JOURNAL_FRAME_HDR - 4))
+            return -1;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+// Walks the records after the magic, loading strings (and frame offsets when
+// s->collect is set). A record cut off by the end of the file ends the walk
+// at s->end, as long as the header bytes it still has agree with its size;
+// any other record that does not parse is corruption and fails the scan,
+// since everything after it is unreachable.
+static int journal_scan(FILE *fp, journal_scan_t *s) {
+    uint8_t hdr[JOURNAL_FRAME_HDR];
+    off_t off = JOURNAL_MAGIC_LEN;
+    if (fseeko(fp, 0, SEEK_END) != 0) return -1;
+    off_t size = ftello(fp);
+    s->size = size;
+    s->end = off;
+    while (off + 5 <= size) {
+        if (fseeko(fp, off, SEEK_SET) != 0 || fread(hdr, 1, 5, fp) != 5) return -1;
+        uint32_t recLen = get32(hdr);
+        off_t next = off + 4 + (off_t)recLen;
+        size_t avail = (hdr[4] == JOURNAL_REC_STRING) ? JOURNAL_STRING_HDR : JOURNAL_FRAME_HDR;
+        if ((off_t)avail > size - off) avail = (size_t)(size - off);
+        if (fread(hdr + 5, 1, avail - 5, fp) != avail - 5) return -1;
+        if (journal_check_header(hdr, avail, recLen, s->strs.n) != 0) return -1;
+        if (next > size) break;
+        if (hdr[4] == JOURNAL_REC_STRING) {
+            uint16_t len = get16(hdr + 9);
+            char *str = (char *)malloc((size_t)len + 1);
+            if (!str) return -1;
+            if (fread(str, 1, len, fp) != len) {
+                free(str);
+                return -1;
+            }
+            str[len] = '\0';
+            if (strings_push(&s->strs, str) != 0) {
+                free(str);
+                return -1;
+            }
+        } else if (hdr[4] == JOURNAL_REC_FRAME) {
+            if (s->collect) {
+                if (s->nframes == s->cap) {
+                    size_t cap = s->cap ? s->cap * 2 : 256;
+                    off_t *frames = (off_t *)realloc(s->frames, cap * sizeof(*frames));
+                    if (!frames) return -1;
+                    s->frames = frames;
+                    s->cap = cap;
+                }
+                s->frames[s->nframes++] = off;
+            }
+        }
+        off = next;
+        s->end = off;
+    }
+    return 0;
+}
+
+static int journal_flush(HexJournal_t *j) {
+    if (j->len && fwrite(j->buf, 1, j->len, j->fp) != j->len) j->failed = true;
+    j->len = 0;
+    return j->failed ? -1 : 0;
+}
+
+// Copies into the record buffer, going around it for pieces larger than the buffer.
+static void journal_put(HexJournal_t *j, const void *data, size_t n) {
+    if (j->len + n > j->cap) {
+        journal_flush(j);
+        if (n > j->cap) {
+            if (fwrite(data, 1, n, j->fp) != n) j->failed = true;
+            return;
+        }
+    }
+    memcpy(j->buf + j->len, data, n);
+    j->len += n;
+}
+
+// Rebuilds the hash slots for nslots entries (a power of two).
+static int journal_rehash(HexJournal_t *j, uint32_t nslots) {
+    uint32_t *slots = (uint32_t *)calloc(nslots, sizeof(*slots));
+    if (!slots) return -1;
+    for (uint32_t id = 1; id <= j->strs.n; id++) {
+        uint32_t k = str_hash(j->strs.str[id]) & (nslots - 1);
+        while (slots[k]) k = (k + 1) & (nslots - 1);
+        slots[k] = id;
+    }
+    free(j->slots);
+    j->slots = slots;
+    j->nslots = nslots;
+    return 0;
+}
+
+// Id of s in the journal's string table, writing a string record on first use.
+// Returns 0 for NULL and -1 when s is too long or out of memory.
+static int64_t journal_intern(HexJournal_t *j, const char *s) {
+    if (!s) return 0;
+    uint32_t h = str_hash(s), k = h & (j->nslots - 1);
+    for (; j->slots[k]; k = (k + 1) & (j->nslots - 1)) {
+        if (strcmp(j->strs.str[j->slots[k]], s) == 0) return j->slots[k];
+    }
+    size_t len = strlen(s);
+    if (len > UINT16_MAX) return -1;
+    char *copy = (char *)malloc(len + 1);
+    if (!copy) return -1;
+    memcpy(copy, s, len + 1);
+    if (strings_push(&j->strs, copy) != 0) {
+        free(copy);
+        return -1;
+    }
+    uint32_t id = j->strs.n;
+    if ((uint64_t)id * 2 >= j->nslots) {
+        if (j->nslots > UINT32_MAX / 2 || journal_rehash(j, j->nslots * 2) != 0) {
+            j->strs.n--;
+            free(copy);
+            return -1;
+        }
+    } else {
+        j->slots[k] = id;
+    }
+
+    uint8_t hdr[JOURNAL_STRING_HDR];
+    put32(hdr, (uint32_t)(JOURNAL_STRING_HDR - 4 + len));
+    hdr[4] = JOURNAL_REC_STRING;
+    put32(hdr + 5, id);
+    put16(hdr + 9, (uint16_t)len);
+    journal_put(j, hdr, sizeof(hdr));
+    journal_put(j, s, len);
+    return id;
+}
+
+static void journal_close_file(HexJournal_t *j) {
+    strings_free(&j->strs);
+    free(j->slots);
+    free(j->ids);
+    free(j->buf);
+    free(j);
+}
+
+
+static HexJournal_t *__h_E_x_J_o_U_r_N_a_L_o_P_e_N__(const char *path, size_t bufBytes) {
+    if (!path) return NULL;
+    HexJournal_t *j = (HexJournal_t *)calloc(1, sizeof(*j));
+    if (!j) return NULL;
+    j->cap = bufBytes ? bufBytes : JOURNAL_BUF_BYTES;
+    j->buf = (uint8_t *)malloc(j->cap);
+    j->fp = fopen(path, "r+b");
+    if (!j->fp) j->fp = fopen(path, "w+b");
+    if (!j->buf || !j->fp || journal_rehash(j, 64) != 0) goto fail;
+
+    char magic[JOURNAL_MAGIC_LEN];
+    size_t got = fread(magic, 1, JOURNAL_MAGIC_LEN, j->fp);
+    if (got == 0) {
+        if (fseeko(j->fp, 0, SEEK_SET) != 0 || fwrite(JOURNAL_MAGIC, 1, JOURNAL_MAGIC_LEN, j->fp) != JOURNAL_MAGIC_LEN)
+            goto fail;
+        return j;
+    }
+    if (got != JOURNAL_MAGIC_LEN || memcmp(magic, JOURNAL_MAGIC, JOURNAL_MAGIC_LEN) != 0) goto fail;
+
+    journal_scan_t scan = { 0 };
+    int rc = journal_scan(j->fp, &scan);
+    j->strs = scan.strs;
+    if (rc != 0) goto fail;
+    uint32_t nslots = 64;
+    while (nslots / 2 <= j->strs.n) nslots *= 2;
+    if (journal_rehash(j, nslots) != 0) goto fail;
+    // Drop a record torn by a crash so new entries follow the last good one.
+    // Only a short tail gets here: corruption further in failed the scan.
+    if (fflush(j->fp) != 0 || (scan.end < scan.size && ftruncate(fileno(j->fp), scan.end) != 0) ||
+        fseeko(j->fp, scan.end, SEEK_SET) != 0)
+        goto fail;
+    return j;
+
+fail:
+    if (j->fp) fclose(j->fp);
+    journal_close_file(j);
+    return NULL;
+}
+
+static int __h_E_x_J_o_U_r_N_a_L_a_P_p_E_n_D__(HexJournal_t *j, uint64_t timestamp, const uint8_t *buffer,
+                                               size_t buffer_len, const HexJournalRange_t *ranges, size_t nranges,
+                                               const char *title_str) {
+    if (!j || j->failed || (!buffer && buffer_len) || (!ranges && nranges) || nranges > UINT16_MAX) return -1;
+    size_t recLen = JOURNAL_FRAME_HDR - 4 + nranges * JOURNAL_RANGE_BYTES + buffer_len;
+    if (recLen > UINT32_MAX) return -1;
+    STAT_SCOPE_BEGIN(scope);
+
+    for (size_t i = 0; i < nranges; i++) {
+        if (ranges[i].begin > ranges[i].end || (unsigned)ranges[i].errLevel > ANSI_ErrLevel_ERR) return -1;
+    }
+    if (nranges > j->idsCap) {
+        uint32_t *ids = (uint32_t *)realloc(j->ids, nranges * sizeof(*ids));
+        if (!ids) return -1;
+        j->ids = ids;
+        j->idsCap = nranges;
+    }
+    // Any new strings go out ahead of the frame that uses them.
+    int64_t title = journal_intern(j, title_str);
+    if (title < 0) return -1;
+    for (size_t i = 0; i < nranges; i++) {
+        int64_t id = journal_intern(j, ranges[i].colorStr);
+        if (id < 0) return -1;
+        j->ids[i] = (uint32_t)id;
+    }
+
+    uint8_t hdr[JOURNAL_FRAME_HDR];
+    put32(hdr, (uint32_t)recLen);
+    hdr[4] = JOURNAL_REC_FRAME;
+    put32(hdr + 5, (uint32_t)title);
+    put16(hdr + 9, (uint16_t)nranges);
+    put32(hdr + 11, (uint32_t)timestamp);
+    put32(hdr + 15, (uint32_t)(timestamp >> 32));
+    put32(hdr + 19, (uint32_t)buffer_len);
+    journal_put(j, hdr, sizeof(hdr));
+    for (size_t i = 0; i < nranges; i++) {
+        const HexJournalRange_t *r = &ranges[i];
+        uint8_t rec[JOURNAL_RANGE_BYTES] = {
+            r->begin, r->end, 0, 0, 0, 0, (uint8_t)r->errLevel, (uint8_t)r->charBegin, (uint8_t)r->charEnd
+        };
+        put32(rec + 2, j->ids[i]);
+        journal_put(j, rec, sizeof(rec));
+    }
+    journal_put(j, buffer, buffer_len);
+
+    STAT_SCOPE_END(scope, STAT_HEXJOURNAL_APPEND, buffer_len);
+    return j->failed ? -1 : 0;
+}
+
+static int __h_E_x_J_o_U_r_N_a_L_a_P_p_E_n_D_m_A_p_S__(HexJournal_t *j, uint64_t timestamp, const uint8_t *buffer,
+                                                       size_t buffer_len, const ANSIColorMap256_t *ansiMap,
+                                                       const ANSIErrTagMap256_t *errMap, const char *title_str) {
+    // One range per run of equal colour and level, then one per bracket. The
+    // whole map is kept: the renderer also reads it past the end of short frames.
+    HexJournalRange_t ranges[512];
+    size_t n = 0, span = 256;
+    for (size_t i = 0; i < span;) {
+        const char *color = ansiMap ? ansiMap->ansiColorStr[i] : NULL;
+        ANSI_ErrLevel_t level = errMap ? errMap->errLevel[i] : ANSI_ErrLevel_NML;
+        size_t end = i;
+        while (end + 1 < span && (ansiMap ? ansiMap->ansiColorStr[end + 1] : NULL) == color &&
+               (errMap ? errMap->errLevel[end + 1] : ANSI_ErrLevel_NML) == level)
+            end++;
+        if (color || level != ANSI_ErrLevel_NML)
+            ranges[n++] = (HexJournalRange_t){ (uint8_t)i, (uint8_t)end, color, 0, 0, level };
+        i = end + 1;
+    }
+    for (size_t i = 0; ansiMap && i < span; i++) {
+        if (ansiMap->charBegin[i] || ansiMap->charEnd[i])
+            ranges[n++] = (HexJournalRange_t){ (uint8_t)i, (uint8_t)i, NULL, ansiMap->charBegin[i],
+                                               ansiMap->charEnd[i], ANSI_ErrLevel_NML };
+    }
+    return __h_E_x_J_o_U_r_N_a_L_a_P_p_E_n_D__(j, timestamp, buffer, buffer_len, ranges, n, title_str);
+}
+
+static int __h_E_x_J_o_U_r_N_a_L_f_L_u_S_h__(HexJournal_t *j) {
+    if (!j) return -1;
+    int rc = journal_flush(j);
+    if (fflush(j->fp) != 0) rc = -1;
+    return rc;
+}
+
+static int __h_E_x_J_o_U_r_N_a_L_c_L_o_S_e__(HexJournal_t *j) {
+    if (!j) return -1;
+    int rc = __h_E_x_J_o_U_r_N_a_L_f_L_u_S_h__(j);
+    if (fclose(j->fp) != 0) rc = -1;
+    journal_close_file(j);
+    return rc;
+}
+
+static HexJournalReader_t *__h_E_x_J_o_U_r_N_a_L_r_E_a_D_e_R_o_P_e_N__(const char *path) {
+    if (!path) return NULL;
+    HexJournalReader_t *r = (HexJournalReader_t *)calloc(1, sizeof(*r));
+    if (!r) return NULL;
+    r->fp = fopen(path, "rb");
+    char magic[JOURNAL_MAGIC_LEN];
+    r->scan.collect = true;
+    if (!r->fp || fread(magic, 1, JOURNAL_MAGIC_LEN, r->fp) != JOURNAL_MAGIC_LEN ||
+        memcmp(magic, JOURNAL_MAGIC, JOURNAL_MAGIC_LEN) != 0 || journal_scan(r->fp, &r->scan) != 0) {
+        if (r->fp) fclose(r->fp);
+        strings_free(&r->scan.strs);
+        free(r->scan.frames);
+        free(r);
+        return NULL;
+    }
+    return r;
+}
+
+static void __h_E_x_J_o_U_r_N_a_L_r_E_a_D_e_R_c_L_o_S_e__(HexJournalReader_t *r) {
+    if (!r) return;
+    fclose(r->fp);
+    strings_free(&r->scan.strs);
+    free(r->scan.frames);
+    free(r->rec);
+    free(r->ranges);
+    free(r);
+}
+
+static size_t __h_E_x_J_o_U_r_N_a_L_c_O_u_N_t__(const HexJournalReader_t *r) {
+    return r ? r->scan.nframes : 0;
+}
+
+static const HexJournalEntry_t *__h_E_x_J_o_U_r_N_a_L_g_E_t__(HexJournalReader_t *r, size_t index) {
+    if (!r || index >= r->scan.nframes) return NULL;
+    uint8_t size[4];
+    if (fseeko(r->fp, r->scan.frames[index], SEEK_SET) != 0 || fread(size, 1, 4, r->fp) != 4) return NULL;
+    uint32_t recLen = get32(size);
+    if (recLen > r->recCap) {
+        uint8_t *rec = (uint8_t *)realloc(r->rec, recLen);
+        if (!rec) return NULL;
+        r->rec = rec;
+        r->recCap = recLen;
+    }
+    if (fread(r->rec, 1, recLen, r->fp) != recLen) return NULL;
+
+    // Offsets below are relative to the byte after the size field.
+    const uint8_t *p = r->rec;
+    const journal_strings_t *strs = &r->scan.strs;
+    uint32_t title = get32(p + 1);
+    size_t nranges = get16(p + 5);
+    size_t len = get32(p + 15);
+    if ((size_t)JOURNAL_FRAME_HDR - 4 + nranges * JOURNAL_RANGE_BYTES + len != recLen || title > strs->n) return NULL;
+    if (nranges > r->rangeCap) {
+        HexJournalRange_t *ranges = (HexJournalRange_t *)realloc(r->ranges, nranges * sizeof(*ranges));
+        if (!ranges) return NULL;
+        r->ranges = ranges;
+        r->rangeCap = nranges;
+    }
+    const uint8_t *q = p + JOURNAL_FRAME_HDR - 4;
+    for (size_t i = 0; i < nranges; i++, q += JOURNAL_RANGE_BYTES) {
+        uint32_t color = get32(q + 2);
+        if (color > strs->n || q[6] > ANSI_ErrLevel_ERR) return NULL;
+        r->ranges[i] = (HexJournalRange_t){ q[0], q[1], color ? strs->str[color] : NULL, (char)q[7], (char)q[8],
+                                            (ANSI_ErrLevel_t)q[6] };
+    }
+    r->entry.timestamp = (uint64_t)get32(p + 7) | (uint64_t)get32(p + 11) << 32;
+    r->entry.title = title ? strs->str[title] : NULL;
+    r->entry.ranges = r->ranges;
+    r->entry.nranges = nranges;
+    r->entry.data = q;
+    r->entry.len = len;
+    return &r->entry;
+}
+
+static void __h_E_x_J_o_U_r_N_a_L_e_N_t_R_y_M_a_P_s__(const HexJournalEntry_t *e, ANSIColorMap256_t *ansiMap,
+                                                      ANSIErrTagMap256_t *errMap) {
+    if (ansiMap) memset(ansiMap, 0, sizeof(*ansiMap));
+    if (errMap) memset(errMap, 0, sizeof(*errMap));
+    if (!e) return;
+    for (size_t k = 0; k < e->nranges; k++) {
+        const HexJournalRange_t *r = &e->ranges[k];
+        for (unsigned i = r->begin; i <= r->end; i++) {
+            if (ansiMap && r->colorStr) ansiMap->ansiColorStr[i] = r->colorStr;
+            if (errMap && errMap->errLevel[i] < r->errLevel) errMap->errLevel[i] = r->errLevel;
+        }
+        if (ansiMap && r->charBegin) ansiMap->charBegin[r->begin] = r->charBegin;
+        if (ansiMap && r->charEnd) ansiMap->charEnd[r->end] = r->charEnd;
+    }
+}
+
+static char *__h_E_x_J_o_U_r_N_a_L_r_E_n_D_e_R__(HexJournalReader_t *r, size_t index, bool color, const char *tail_str) {
+    const HexJournalEntry_t *e = __h_E_x_J_o_U_r_N_a_L_g_E_t__(r, index);
+    if (!e) return NULL;
+    uint8_t *data = (uint8_t *)e->data;   // points into the reader's own buffer
+    if (!color) return printHexTable256(data, e->len, e->title, tail_str);
+    ANSIColorMap256_t ansiMap;
+    ANSIErrTagMap256_t errMap;
+    __h_E_x_J_o_U_r_N_a_L_e_N_t_R_y_M_a_P_s__(e, &ansiMap, &errMap);
+    return printColorHexTable256(data, e->len, &ansiMap, &errMap, e->title, tail_str);
+}
+
+
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_o_P_e_N__"))) HexJournal_t *hexJournalOpen(const char *path, size_t bufBytes);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_a_P_p_E_n_D__")))
+int hexJournalAppend(HexJournal_t *journal, uint64_t timestamp, const uint8_t *buffer, size_t buffer_len,
+                     const HexJournalRange_t *ranges, size_t nranges, const char *title_str);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_a_P_p_E_n_D_m_A_p_S__")))
+int hexJournalAppendMaps(HexJournal_t *journal, uint64_t timestamp, const uint8_t *buffer, size_t buffer_len,
+                         const ANSIColorMap256_t *ansiMap, const ANSIErrTagMap256_t *errMap, const char *title_str);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_f_L_u_S_h__"))) int hexJournalFlush(HexJournal_t *journal);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_c_L_o_S_e__"))) int hexJournalClose(HexJournal_t *journal);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_r_E_a_D_e_R_o_P_e_N__"))) HexJournalReader_t *hexJournalReaderOpen(const char *path);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_r_E_a_D_e_R_c_L_o_S_e__"))) void hexJournalReaderClose(HexJournalReader_t *reader);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_c_O_u_N_t__"))) size_t hexJournalCount(const HexJournalReader_t *reader);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_g_E_t__")))
+const HexJournalEntry_t *hexJournalGet(HexJournalReader_t *reader, size_t index);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_e_N_t_R_y_M_a_P_s__")))
+void hexJournalEntryMaps(const HexJournalEntry_t *entry, ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap);
+__attribute__((weak, alias("__h_E_x_J_o_U_r_N_a_L_r_E_n_D_e_R__")))
+char* hexJournalRender(HexJournalReader_t *reader, size_t index, bool color, const char *tail_str);
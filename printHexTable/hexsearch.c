@@ -0,0 +1,217 @@
+/*
+ * File:        printHexTable/hexsearch.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Multi-pattern masked byte search for the hex tables.
+ *
+ *    Every pattern is anchored on one fully-specified byte, preferring bytes
+ *    that are rare in captures (not 0x00 / 0xFF / text). The scan only looks
+ *    for anchor bytes: memchr() when the set has a single anchor, 16 / 32
+ *    byte SSE2 / AVX2 compares for up to HEXSEARCH_VEC_ANCHORS, a 256-entry
+ *    table otherwise. Candidates are verified against the masked patterns
+ *    sharing that anchor byte.
+ */
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "printHexTable.h"
+#include <colorUtils/colorutl.h>
+#include <statUtils/statutl.h>
+#include <colorUtils/cpulevel.h>
+
+// Anchor sets up to this size use the vector compare loop.
+#define HEXSEARCH_VEC_ANCHORS 8
+
+typedef int (*hex_scan_fn)(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                           size_t *pos, HexSearchHit_fn cb, void *user, size_t *hits);
+
+// Lower is better: zero and fill bytes, then ASCII text, dominate most captures.
+static int anchor_cost(uint8_t b) {
+    if (b == 0x00 || b == 0xFF) return 3;
+    if (b == ' ' || isalnum(b)) return 2;
+    if (b < 0x80 && isprint(b)) return 1;
+    return 0;
+}
+
+static inline bool pattern_match(const HexPattern_t *pat, const uint8_t *p) {
+    if (!pat->mask) return memcmp(p, pat->bytes, pat->len) == 0;
+    for (size_t i = 0; i < pat->len; i++) {
+        if ((p[i] ^ pat->bytes[i]) & pat->mask[i]) return false;
+    }
+    return true;
+}
+
+// Check every pattern anchored on buf[p]; returns 1 when the callback stops the scan.
+static int verify_at(const HexSearch_t *s, const uint8_t *buf, size_t len, size_t p,
+                     HexSearchHit_fn cb, void *user, size_t *hits) {
+    for (unsigned k = s->head[buf[p]]; k; k = s->next[k - 1]) {
+        const HexPattern_t *pat = &s->pat[k - 1];
+        size_t a = s->anchor[k - 1];
+        if (p < a || pat->len > len - (p - a)) continue;
+        if (!pattern_match(pat, buf + p - a)) continue;
+        (*hits)++;
+        if (cb && cb(p - a, k - 1, user)) return 1;
+    }
+    return 0;
+}
+
+#if defined(__SSE2__)
+static int scan_sse2(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                     size_t *pos, HexSearchHit_fn cb, void *user, size_t *hits) {
+    __m128i anchors[HEXSEARCH_VEC_ANCHORS];
+    for (size_t j = 0; j < s->nanchor; j++) anchors[j] = _mm_set1_epi8((char)s->anchorBytes[j]);
+    size_t i = *pos;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(buf + i));
+        __m128i eq = _mm_cmpeq_epi8(v, anchors[0]);
+        for (size_t j = 1; j < s->nanchor; j++) eq = _mm_or_si128(eq, _mm_cmpeq_epi8(v, anchors[j]));
+        unsigned m = (unsigned)_mm_movemask_epi8(eq);
+        while (m) {
+            if (verify_at(s, buf, len, i + __builtin_ctz(m), cb, user, hits)) return 1;
+            m &= m - 1;
+        }
+    }
+    *pos = i;
+    return 0;
+}
+#endif
+
+#if COLORUTL_X86_DISPATCH
+__attribute__((target("avx2")))
+static int scan_avx2(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                     size_t *pos, HexSearchHit_fn cb, void *user, size_t *hits) {
+    __m256i anchors[HEXSEARCH_VEC_ANCHORS];
+    for (size_t j = 0; j < s->nanchor; j++) anchors[j] = _mm256_set1_epi8((char)s->anchorBytes[j]);
+    size_t i = *pos;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(buf + i));
+        __m256i eq = _mm256_cmpeq_epi8(v, anchors[0]);
+        for (size_t j = 1; j < s->nanchor; j++) eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(v, anchors[j]));
+        unsigned m = (unsigned)_mm256_movemask_epi8(eq);
+        while (m) {
+            if (verify_at(s, buf, len, i + __builtin_ctz(m), cb, user, hits)) return 1;
+            m &= m - 1;
+        }
+    }
+    *pos = i;
+    return 0;
+}
+#endif
+
+static hex_scan_fn hex_scan_impl(void) {
+    return CPU_LEVEL_DISPATCH(hex_scan_fn, NULL, scan_sse2, scan_avx2);
+}
+
+static size_t hex_search_scan(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                              HexSearchHit_fn cb, void *user) {
+    size_t hits = 0;
+    if (!s || !buf || s->npat == 0) return 0;
+
+    if (s->nanchor == 1) {
+        const uint8_t *p = buf, *end = buf + len;
+        while (p < end && (p = memchr(p, s->anchorBytes[0], (size_t)(end - p)))) {
+            if (verify_at(s, buf, len, (size_t)(p - buf), cb, user, &hits)) break;
+            p++;
+        }
+        return hits;
+    }
+
+    size_t i = 0;
+    hex_scan_fn impl = (s->nanchor <= HEXSEARCH_VEC_ANCHORS) ? hex_scan_impl() : NULL;
+    if (impl && impl(s, buf, len, &i, cb, user, &hits)) return hits;
+    for (; i < len; i++) {
+        if (s->head[buf[i]] && verify_at(s, buf, len, i, cb, user, &hits)) break;
+    }
+    return hits;
+}
+
+
+static int __h_E_x_S_e_A_r_C_h_I_n_I_t__(HexSearch_t *s, const HexPattern_t *patterns, size_t npatterns) {
+    if (!s || (!patterns && npatterns) || npatterns > HEXSEARCH_MAX_PATTERNS) return -1;
+    memset(s, 0, sizeof(*s));
+    s->pat = patterns;
+
+    bool used[256] = { false };
+    for (size_t k = 0; k < npatterns; k++) {
+        const HexPattern_t *pat = &patterns[k];
+        if (!pat->bytes || pat->len == 0) return -1;
+
+        // Cheapest fully-specified byte; ties go to a byte already anchoring
+        // another pattern, which keeps the anchor set small enough to vectorise.
+        int best = -1, best_cost = 0;
+        for (size_t i = 0; i < pat->len; i++) {
+            if (pat->mask && pat->mask[i] != 0xFF) continue;
+            uint8_t b = pat->bytes[i];
+            int cost = anchor_cost(b) * 2 + (used[b] ? 0 : 1);
+            if (best < 0 || cost < best_cost) {
+                best = (int)i;
+                best_cost = cost;
+            }
+        }
+        if (best < 0) return -1;
+
+        uint8_t b = pat->bytes[best];
+        s->anchor[k] = (size_t)best;
+        if (!used[b]) {
+            used[b] = true;
+            s->anchorBytes[s->nanchor++] = b;
+        }
+        // Append so patterns sharing an anchor are verified in caller order.
+        uint8_t *link = &s->head[b];
+        while (*link) link = &s->next[*link - 1];
+        *link = (uint8_t)(k + 1);
+        if (pat->len > s->maxLen) s->maxLen = pat->len;
+    }
+    s->npat = npatterns;
+    return 0;
+}
+
+static size_t __h_E_x_S_e_A_r_C_h_S_c_A_n__(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                                           HexSearchHit_fn cb, void *user) {
+    STAT_SCOPE_BEGIN(scope);
+    size_t hits = hex_search_scan(s, buf, len, cb, user);
+    STAT_SCOPE_END(scope, STAT_HEXSEARCH, len);
+    return hits;
+}
+
+typedef struct {
+    const HexSearch_t *s;
+    ANSIColorMap256_t *colorMap;
+    ANSIErrTagMap256_t *errMap;
+} tag_ctx_t;
+
+static int tag_hit(size_t pos, size_t pattern, void *user) {
+    tag_ctx_t *t = (tag_ctx_t *)user;
+    const HexPattern_t *pat = &t->s->pat[pattern];
+    uint8_t begin = (uint8_t)pos;
+    uint8_t end = (uint8_t)(pos + pat->len - 1);
+    if (t->colorMap && (pat->colorStr || pat->charBegin || pat->charEnd)) {
+        addr2AnsiColorMap256(t->colorMap, begin, end, pat->colorStr, begin, pat->charBegin, end, pat->charEnd, false);
+    }
+    if (t->errMap && pat->errLevel != ANSI_ErrLevel_NML) {
+        addr2AnsiErrTag256(t->errMap, begin, end, pat->errLevel);
+    }
+    return 0;
+}
+
+static size_t __h_E_x_S_e_A_r_C_h_T_a_G_2_5_6__(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                                                ANSIColorMap256_t *colorMap, ANSIErrTagMap256_t *errMap) {
+    tag_ctx_t t = { s, colorMap, errMap };
+    return __h_E_x_S_e_A_r_C_h_S_c_A_n__(s, buf, (len > 256) ? 256 : len, tag_hit, &t);
+}
+
+
+__attribute__((weak, alias("__h_E_x_S_e_A_r_C_h_I_n_I_t__")))
+int hexSearchInit(HexSearch_t *s, const HexPattern_t *patterns, size_t npatterns);
+__attribute__((weak, alias("__h_E_x_S_e_A_r_C_h_S_c_A_n__")))
+size_t hexSearchScan(const HexSearch_t *s, const uint8_t *buf, size_t len, HexSearchHit_fn cb, void *user);
+__attribute__((weak, alias("__h_E_x_S_e_A_r_C_h_T_a_G_2_5_6__")))
+size_t hexSearchTag256(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                       ANSIColorMap256_t *colorMap, ANSIErrTagMap256_t *errMap);
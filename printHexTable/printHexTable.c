@@ -20,10 +20,128 @@
 #include <string.h>
 #include <math.h>
 #include <stdint.h>
-//#include "printHexTable.h"
-#include "ANSI_types.h"
+#include "printHexTable.h"
 #include <colorUtils/colorutl.h>
 #include <printfUtils/printfutl.h>
+#include <statUtils/statutl.h>
+#include <colorUtils/cpulevel.h>
+
+
+// Hex-encode kernels: n bytes -> 2n uppercase hex digits (not terminated).
+// The vector bodies take 16 bytes per step and leave the remainder to the
+// scalar loop; the level is picked once from cpuLevel().
+typedef void (*hex_encode_fn)(char *dst, const uint8_t *src, size_t n, size_t *done);
+
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+#if defined(__SSE2__)
+static inline __m128i hex_digits_sse2(__m128i nib) {
+    __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(nib, _mm_set1_epi8(9)), _mm_set1_epi8('A' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nib, _mm_set1_epi8('0')), alpha);
+}
+
+static void hex_encode_sse2(char *dst, const uint8_t *src, size_t n, size_t *done) {
+    const __m128i low = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i hi = hex_digits_sse2(_mm_and_si128(_mm_srli_epi16(v, 4), low));
+        __m128i lo = hex_digits_sse2(_mm_and_si128(v, low));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    *done = i;
+}
+#endif
+
+#if COLORUTL_X86_DISPATCH
+// Each byte is widened to a 16-bit lane holding (high nibble, low nibble), which
+// is already the output order, so no cross-lane shuffle is needed.
+__attribute__((target("avx2")))
+static void hex_encode_avx2(char *dst, const uint8_t *src, size_t n, size_t *done) {
+    const __m256i low = _mm256_set1_epi16(0x000F);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i w = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(src + i)));
+        __m256i nib = _mm256_or_si256(_mm256_srli_epi16(w, 4), _mm256_slli_epi16(_mm256_and_si256(w, low), 8));
+        __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(nib, _mm256_set1_epi8(9)), _mm256_set1_epi8('A' - '0' - 10));
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i),
+                            _mm256_add_epi8(_mm256_add_epi8(nib, _mm256_set1_epi8('0')), alpha));
+    }
+    *done = i;
+}
+#endif
+
+static hex_encode_fn hex_encode_impl(void) {
+    return CPU_LEVEL_DISPATCH(hex_encode_fn, NULL, hex_encode_sse2, hex_encode_avx2);
+}
+
+static void hex_encode(char *dst, const uint8_t *src, size_t n) {
+    hex_encode_fn impl = hex_encode_impl();
+    size_t i = 0;
+    if (impl) impl(dst, src, n, &i);
+    for (; i < n; i++) {
+        dst[2 * i] = HEX_DIGITS[src[i] >> 4];
+        dst[2 * i + 1] = HEX_DIGITS[src[i] & 0x0F];
+    }
+}
+
+// Number of real bytes in the 16-byte row starting at base.
+static inline size_t hex_row_len(size_t buffer_len, size_t base) {
+    if (buffer_len <= base) return 0;
+    return (buffer_len - base < 16) ? buffer_len - base : 16;
+}
+
+
+// Sequential reader over the caller's segments. Rows are handed out as
+// pointers into the segments themselves; only a row that straddles a segment
+// boundary is gathered into the caller's 16-byte scratch.
+typedef struct {
+    const HexSeg_t *seg;
+    size_t nseg;
+    size_t idx;
+    size_t off;
+} hex_src_t;
+
+// Total length, or (size_t)-1 when a non-empty segment has no data pointer.
+static size_t hex_src_init(hex_src_t *src, const HexSeg_t *seg, size_t nseg) {
+    size_t total = 0;
+    src->seg = seg;
+    src->nseg = seg ? nseg : 0;
+    src->idx = 0;
+    src->off = 0;
+    for (size_t i = 0; i < src->nseg; i++) {
+        if (!seg[i].ptr && seg[i].len) return (size_t)-1;
+        total += seg[i].len;
+    }
+    return total;
+}
+
+static const uint8_t *hex_src_take(hex_src_t *src, size_t n, uint8_t scratch[16]) {
+    while (src->idx < src->nseg && src->off >= src->seg[src->idx].len) {
+        src->idx++;
+        src->off = 0;
+    }
+    if (src->idx < src->nseg && src->seg[src->idx].len - src->off >= n) {
+        const uint8_t *p = src->seg[src->idx].ptr + src->off;
+        src->off += n;
+        return p;
+    }
+    size_t got = 0;
+    while (got < n && src->idx < src->nseg) {
+        const HexSeg_t *s = &src->seg[src->idx];
+        size_t take = s->len - src->off;
+        if (take > n - got) take = n - got;
+        memcpy(scratch + got, s->ptr + src->off, take);
+        got += take;
+        src->off += take;
+        if (src->off == s->len) {
+            src->idx++;
+            src->off = 0;
+        }
+    }
+    return scratch;
+}
 
 
 static char* __g_E_n_R_a_I_n_B_o_W_S_t_R__(const char* str) {
@@ -74,11 +192,12 @@ static char* __p_R_i_N_t_H_e_X_t_A_b_L_e_T_a_I_l__(bool color, const char* str)
     //if (!truncated && (orig_len % 2 != 0)) right_pad++;
 
     size_t buffer_size = left_pad + right_pad + strlen(display_str) + 8;
-    char* buffer = malloc(buffer_size);
+    char* buffer = utlAlloc(buffer_size);
     if (!buffer) {
-        free(rainbow_str);
+        utlFree(rainbow_str);
         return NULL;
     }
+    STAT_ALLOC();
 
     char* p = buffer;
     p += sprintf(p, "+-");
@@ -88,12 +207,14 @@ static char* __p_R_i_N_t_H_e_X_t_A_b_L_e_T_a_I_l__(bool color, const char* str)
     p += sprintf(p, "+\n");
     *p = '\0';
 
-    free(rainbow_str);
+    utlFree(rainbow_str);
     return buffer;
 }
 
-static char* __p_R_i_N_t_H_e_X_t_A_b_L_e_2_5_6__(uint8_t *buffer, size_t buffer_len, const char *title_str, const char *tail_str) {
-    if (!buffer) return NULL;
+static char* printHexTable256_render(const HexSeg_t *segs, size_t nsegs, const char *title_str, const char *tail_str) {
+    hex_src_t src;
+    size_t buffer_len = hex_src_init(&src, segs, nsegs);
+    if (!segs || buffer_len == (size_t)-1) return NULL;
     char *dst_buf = NULL;
     char *title_buf = NULL;
     char *return_buf = NULL;
@@ -111,41 +232,35 @@ static char* __p_R_i_N_t_H_e_X_t_A_b_L_e_2_5_6__(uint8_t *buffer, size_t buffer_
     const char* tail_buf = (tail_alloc_buf) ? tail_alloc_buf : tail_header_str;
 
     for (uint8_t row = 0; row < 16; row++) {
-        char ascii[17] = {0};  // Collect 16 ASCII chars
-        sappendf(&dst_buf, "+ %X|", row);
-        //printf("+ %X|", row);
-        for (uint8_t col = 0; col < 16; col++) {
-            uint8_t i = row * 16 + col;
-            if (i < buffer_len) {
-                sappendf(&dst_buf, " %02X ", buffer[i]);
-                //printf(" %02X ", buffer[i]);
-                ascii[col] = isprint(buffer[i]) ? buffer[i] : 0;
-            } else {
-                sappendf(&dst_buf, " XX ");
-                //printf(" XX ");
-                ascii[col] = 0;
-            }
+        // Build the whole row locally and append it once.
+        char line[96];
+        char hex[32];
+        uint8_t scratch[16];
+        size_t base = row * 16;
+        size_t n = hex_row_len(buffer_len, base);
+        const uint8_t *bytes = hex_src_take(&src, n, scratch);
+        char *p = line;
+        hex_encode(hex, bytes, n);
+        p += sprintf(p, "+ %X|", row);
+        for (size_t col = 0; col < 16; col++) {
+            *p++ = ' ';
+            *p++ = (col < n) ? hex[2 * col] : 'X';
+            *p++ = (col < n) ? hex[2 * col + 1] : 'X';
+            *p++ = ' ';
         }
-        ascii[16] = '\0'; // null-terminate
-        sappendf(&dst_buf, "| ");
-        //printf("| ");
-        for (uint8_t k = 0; k < 16; k++) {
-            uint8_t idx = row * 16 + k;
-            uint8_t c = (idx < buffer_len) ? buffer[idx] : 0xFF;
-            if (ascii[k]) {
-                //printf("%", ascii[k]);
-                //putchar(ascii[k]);
-                sappendf(&dst_buf, "%c", ascii[k]);
-            } else if (idx >= buffer_len) {
-                //printf(" ");
-                sappendf(&dst_buf, " ");
+        *p++ = '|';
+        *p++ = ' ';
+        for (size_t k = 0; k < 16; k++) {
+            if (k >= n) {
+                *p++ = ' ';
             } else {
-                if (c == 0x00) sappendf(&dst_buf, " "); //printf(" ");
-                else sappendf(&dst_buf, "."); //printf(".");
+                uint8_t c = bytes[k];
+                if (isprint(c)) *p++ = c;
+                else *p++ = (c == 0x00) ? ' ' : '.';
             }
         }
-        sappendf(&dst_buf, " |+\n");
-        //printf(" |+\n");
+        memcpy(p, " |+\n", 5);
+        sappendf(&dst_buf, "%s", line);
     }
     
     sappendf(&title_buf, "+");
@@ -178,17 +293,19 @@ static char* __p_R_i_N_t_H_e_X_t_A_b_L_e_2_5_6__(uint8_t *buffer, size_t buffer_
     
     sappendf(&title_buf, "%s", title_header_str);
     sappendf(&return_buf, "%s%s%s", title_buf, dst_buf, tail_buf);
-    free(title_buf);
-    free(dst_buf);
-    free(tail_alloc_buf);
+    utlFree(title_buf);
+    utlFree(dst_buf);
+    utlFree(tail_alloc_buf);
     return return_buf;
 }
 
-static char* __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6__(uint8_t* buffer, size_t buffer_len, 
-                                                           ANSIColorMap256_t *ansiMap, 
-                                                           ANSIErrTagMap256_t *errMap, 
-                                                           const char* title_str, const char* tail_str) {
-    if (!buffer) return NULL;
+static char* printColorHexTable256_render(const HexSeg_t *segs, size_t nsegs,
+                                          ANSIColorMap256_t *ansiMap, 
+                                          ANSIErrTagMap256_t *errMap, 
+                                          const char* title_str, const char* tail_str) {
+    hex_src_t src;
+    size_t buffer_len = hex_src_init(&src, segs, nsegs);
+    if (!segs || buffer_len == (size_t)-1) return NULL;
     char *dst_buf = NULL;
     char *title_buf = NULL;
     char *return_buf = NULL;
@@ -277,6 +394,11 @@ static char* __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6__(uint8_t* buffer, size
         //printf("%s+ %X|%s", ANSI_LEVEL_COLOR[maxRowLevel], row, RESET);
         char ascii[17] = {0};  // Collect 16 ASCII chars
         const char* asciiColor[16] = {0};  // Store color for each ASCII cell
+        char hex[32];
+        uint8_t scratch[16];
+        size_t n = hex_row_len(buffer_len, base);
+        const uint8_t *bytes = hex_src_take(&src, n, scratch);
+        hex_encode(hex, bytes, n);
         for (uint8_t col = 0; col < 16; col++) {
             uint8_t i = row * 16 + col;
             // Defaults
@@ -287,12 +409,12 @@ static char* __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6__(uint8_t* buffer, size
             // Print Hex Byte
             if (i < buffer_len) {
                 if (color) {
-                    sappendf(&dst_buf, "%s%c%02X%c%s", color, left, buffer[i], right, RESET);
+                    sappendf(&dst_buf, "%s%c%.2s%c%s", color, left, hex + 2 * col, right, RESET);
                 } else {
-                    sappendf(&dst_buf, "%c%02X%c", left, buffer[i], right);
+                    sappendf(&dst_buf, "%c%.2s%c", left, hex + 2 * col, right);
                 }
                 //printf("%s%c%02X%c%s", color, left, buffer[i], right, RESET);
-                ascii[col] = isprint(buffer[i]) ? buffer[i] : 0; 
+                ascii[col] = isprint(bytes[col]) ? bytes[col] : 0; 
                 asciiColor[col] = color;
             } else {
                 sappendf(&dst_buf, "%s%cXX%c%s", "\e[1;31m", left, right, RESET);
@@ -307,7 +429,7 @@ static char* __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6__(uint8_t* buffer, size
         
         for (uint8_t k = 0; k < 16; k++) {
             uint8_t idx = row * 16 + k;
-            uint8_t c = (idx < buffer_len) ? buffer[idx] : 0xFF;
+            uint8_t c = (idx < buffer_len) ? bytes[k] : 0xFF;
             const char* color = asciiColor[k];
             if (ascii[k]) {
                 if (color) {
@@ -338,12 +460,61 @@ static char* __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6__(uint8_t* buffer, size
     }
     sappendf(&return_buf, "%s%s%s", title_buf, dst_buf, tail_buf);
 
-    free(title_buf);
-    free(dst_buf);
-    free(tail_alloc_buf);
+    utlFree(title_buf);
+    utlFree(dst_buf);
+    utlFree(tail_alloc_buf);
     return return_buf;
 }
 
+static char* __p_R_i_N_t_H_e_X_t_A_b_L_e_2_5_6_v__(const HexSeg_t *segs, size_t nsegs, const char *title_str, const char *tail_str) {
+    STAT_SCOPE_BEGIN(scope);
+    char *out = printHexTable256_render(segs, nsegs, title_str, tail_str);
+    STAT_SCOPE_END(scope, STAT_HEXTABLE256, out ? strlen(out) : 0);
+    return out;
+}
+
+static char* __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6_v__(const HexSeg_t *segs, size_t nsegs,
+                                                             ANSIColorMap256_t *ansiMap, 
+                                                             ANSIErrTagMap256_t *errMap, 
+                                                             const char* title_str, const char* tail_str) {
+    STAT_SCOPE_BEGIN(scope);
+    char *out = printColorHexTable256_render(segs, nsegs, ansiMap, errMap, title_str, tail_str);
+    STAT_SCOPE_END(scope, STAT_COLORHEXTABLE256, out ? strlen(out) : 0);
+    return out;
+}
+
+static char* __p_R_i_N_t_H_e_X_t_A_b_L_e_2_5_6__(uint8_t *buffer, size_t buffer_len, const char *title_str, const char *tail_str) {
+    if (!buffer) return NULL;
+    HexSeg_t seg = { buffer, buffer_len };
+    return __p_R_i_N_t_H_e_X_t_A_b_L_e_2_5_6_v__(&seg, 1, title_str, tail_str);
+}
+
+static char* __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6__(uint8_t* buffer, size_t buffer_len, 
+                                                           ANSIColorMap256_t *ansiMap, 
+                                                           ANSIErrTagMap256_t *errMap, 
+                                                           const char* title_str, const char* tail_str) {
+    if (!buffer) return NULL;
+    HexSeg_t seg = { buffer, buffer_len };
+    return __p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6_v__(&seg, 1, ansiMap, errMap, title_str, tail_str);
+}
+
+// A window of len bytes starting at start in a ring of ring_size bytes: one
+// segment, or two when the window wraps past the end.
+static size_t __h_E_x_R_i_N_g_V_i_E_w__(HexSeg_t view[2], const uint8_t *ring, size_t ring_size,
+                                       size_t start, size_t len) {
+    if (!view || !ring || ring_size == 0) return 0;
+    if (len > ring_size) len = ring_size;
+    start %= ring_size;
+    size_t first = ring_size - start;
+    if (len <= first) {
+        view[0] = (HexSeg_t){ ring + start, len };
+        return 1;
+    }
+    view[0] = (HexSeg_t){ ring + start, first };
+    view[1] = (HexSeg_t){ ring, len - first };
+    return 2;
+}
+
 
 static void __a_d_d_r_2_A_n_s_i_C_o_l_o_r_M_a_p_2_5_6__(ANSIColorMap256_t *colorMap,
                                                         uint8_t colorAddrBegin, uint8_t colorAddrEnd, 
@@ -354,7 +525,7 @@ static void __a_d_d_r_2_A_n_s_i_C_o_l_o_r_M_a_p_2_5_6__(ANSIColorMap256_t *color
     // End Addr Must Bigger Then Begin Addr. 
     if (colorAddrEnd < colorAddrBegin || charAddrEnd < charAddrBegin) return;
     
-    for (uint8_t i = colorAddrBegin; i < colorAddrEnd + 1; i++) {
+    for (unsigned i = colorAddrBegin; i <= colorAddrEnd; i++) {
         if (overwrite || colorMap->ansiColorStr[i] == NULL) {
             colorMap->ansiColorStr[i] = colorStr;
         }
@@ -375,7 +546,7 @@ static void __a_d_d_r_2_A_n_s_i_E_r_r_T_a_g_2_5_6__(ANSIErrTagMap256_t *errMap,
                                                     uint8_t errAddrBegin, uint8_t errAddrEnd, ANSI_ErrLevel_t errLevel) {
     if (!errMap) return;
     if (errAddrEnd < errAddrBegin) return;
-    for (uint8_t i = errAddrBegin; i < errAddrEnd + 1; i++) {
+    for (unsigned i = errAddrBegin; i <= errAddrEnd; i++) {
         if (errMap->errLevel[i] < errLevel) errMap->errLevel[i] = errLevel;
     }
     return;
@@ -390,6 +561,13 @@ char* printHexTable256(uint8_t *buffer, size_t buffer_len, const char *title_str
 __attribute__((weak, alias("__p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6__"))) 
 char* printColorHexTable256(uint8_t* buffer, size_t buffer_len, ANSIColorMap256_t *ansiMap,
                             ANSIErrTagMap256_t *errMap, const char* title_str, const char* tail_str);
+__attribute__((weak, alias("__p_R_i_N_t_H_e_X_t_A_b_L_e_2_5_6_v__")))
+char* printHexTable256v(const HexSeg_t *segs, size_t nsegs, const char *title_str, const char *tail_str);
+__attribute__((weak, alias("__p_r_i_n_t_C_o_l_o_r_H_e_x_T_a_b_l_e_2_5_6_v__")))
+char* printColorHexTable256v(const HexSeg_t *segs, size_t nsegs, ANSIColorMap256_t *ansiMap,
+                             ANSIErrTagMap256_t *errMap, const char* title_str, const char* tail_str);
+__attribute__((weak, alias("__h_E_x_R_i_N_g_V_i_E_w__")))
+size_t hexRingView(HexSeg_t view[2], const uint8_t *ring, size_t ring_size, size_t start, size_t len);
 __attribute__((weak, alias("__a_d_d_r_2_A_n_s_i_C_o_l_o_r_M_a_p_2_5_6__"))) 
 void addr2AnsiColorMap256(ANSIColorMap256_t *colorMap, uint8_t colorAddrBegin, uint8_t colorAddrEnd, 
                           const char *colorStr,
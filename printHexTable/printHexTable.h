@@ -11,6 +11,25 @@
  *    WAN, ERR), making it ideal for debugging binary data, memory dumps, or
  *    protocol payloads directly in the terminal.
  *
+ *    The *v variants take the bytes as an array of segments (e.g. a header
+ *    struct, a wrapped DMA ring and a separate CRC) and render them as one
+ *    frame: offsets and map indices run continuously across segments, and the
+ *    segments are read in place.
+ *
+ *    hexSearch* (hexsearch.c) finds sets of masked byte patterns (sync words,
+ *    node IDs, magic values) in buffers of any size and can tag the hits in
+ *    the colour / error maps directly.
+ *
+ *    hexCrcTag256* (hexcrc.c) is a pre-pass that checks a CRC trailer with a
+ *    crcUtils engine and tags a mismatch before the table is rendered.
+ *
+ *    hexCache* (hexcache.c) is an optional bounded LRU cache of rendered
+ *    tables for frames that repeat byte-for-byte; lookups are thread safe.
+ *
+ *    hexJournal* (hexjournal.c) appends raw frames with their timestamp and
+ *    annotations to a compact binary journal on the hot path; a reader
+ *    indexes the journal and renders any entry later.
+ *
  */
 
 #ifndef PRINTHEXTABLE_H
@@ -21,7 +40,76 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <printHexTable/ANSI_types.h> // ANSI types defines, enums and structures... etc.
+#include <crcUtils/crcutl.h>
+
+// One piece of a non-contiguous frame.
+typedef struct {
+    const uint8_t *ptr;
+    size_t len;
+} HexSeg_t;
+
+#define HEXSEARCH_MAX_PATTERNS 64
+
+// A byte pattern and the annotation hexSearchTag256() applies to its hits.
+typedef struct {
+    const uint8_t *bytes;
+    const uint8_t *mask;        // NULL: exact match; else only the bits set in mask are compared
+    size_t len;
+    const char *colorStr;       // NULL: leave the colour map alone
+    char charBegin, charEnd;    // brackets around the hit, 0 for none
+    ANSI_ErrLevel_t errLevel;   // NML: leave the error map alone
+} HexPattern_t;
+
+// Compiled pattern set. Each pattern is prefiltered on one fully-specified
+// "anchor" byte; candidates are verified against the whole masked pattern.
+typedef struct {
+    const HexPattern_t *pat;    // caller's array, must outlive the searcher
+    size_t npat;
+    size_t maxLen;
+    size_t anchor[HEXSEARCH_MAX_PATTERNS];  // anchor offset within each pattern
+    uint8_t head[256];          // first pattern + 1 anchored on each byte value, 0: none
+    uint8_t next[HEXSEARCH_MAX_PATTERNS];   // next pattern + 1 with the same anchor byte
+    uint8_t anchorBytes[HEXSEARCH_MAX_PATTERNS];
+    size_t nanchor;             // distinct anchor bytes
+} HexSearch_t;
+
+// Opaque render cache (hexcache.c).
+typedef struct HexCache HexCache_t;
+
+typedef struct {
+    uint64_t hits, misses, evictions;
+    size_t entries;
+    size_t bytes;               // entries plus bookkeeping
+    size_t maxBytes;
+} HexCacheStats_t;
+
+// One annotation of a journal entry: colour and level over [begin, end] and
+// brackets at either end, as addr2AnsiColorMap256() / addr2AnsiErrTag256() set them.
+typedef struct {
+    uint8_t begin, end;         // map indices, inclusive
+    const char *colorStr;       // NULL: no colour
+    char charBegin, charEnd;    // 0 for none
+    ANSI_ErrLevel_t errLevel;
+} HexJournalRange_t;
+
+// An entry read back by hexJournalGet(); valid until the next call on the reader.
+typedef struct {
+    uint64_t timestamp;
+    const char *title;          // NULL if none was recorded
+    const uint8_t *data;
+    size_t len;
+    const HexJournalRange_t *ranges;
+    size_t nranges;
+} HexJournalEntry_t;
+
+// Opaque journal writer and reader (hexjournal.c).
+typedef struct HexJournal HexJournal_t;
+typedef struct HexJournalReader HexJournalReader_t;
+
+// Called for each hit with the offset of its first byte; return nonzero to stop.
+typedef int (*HexSearchHit_fn)(size_t pos, size_t pattern, void *user);
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +121,82 @@ char* printHexTable256(uint8_t *buffer, size_t buffer_len, const char *title_str
 char* printColorHexTable256(uint8_t* buffer, size_t buffer_len, ANSIColorMap256_t *ansiMap,
                             ANSIErrTagMap256_t *errMap, const char* title_str, const char* tail_str);
 
+char* printHexTable256v(const HexSeg_t *segs, size_t nsegs, const char *title_str, const char *tail_str);
+char* printColorHexTable256v(const HexSeg_t *segs, size_t nsegs, ANSIColorMap256_t *ansiMap,
+                             ANSIErrTagMap256_t *errMap, const char* title_str, const char* tail_str);
+
+// Fill view with the len bytes starting at start in a ring buffer; returns the
+// number of segments used (2 when the window wraps, 0 on bad arguments).
+size_t hexRingView(HexSeg_t view[2], const uint8_t *ring, size_t ring_size, size_t start, size_t len);
+
+// Returns -1 for too many patterns, or a pattern that is empty or has no byte
+// with a full 0xFF mask to anchor on.
+int hexSearchInit(HexSearch_t *s, const HexPattern_t *patterns, size_t npatterns);
+// Reports every hit lying wholly inside buf, in order of anchor position;
+// returns the number reported. To cover a file in chunks, overlap them by
+// s->maxLen - 1 bytes and drop hits that start in the overlap.
+size_t hexSearchScan(const HexSearch_t *s, const uint8_t *buf, size_t len, HexSearchHit_fn cb, void *user);
+// Scans the first 256 bytes and applies each hit's annotation (without
+// overwriting existing colours); either map may be NULL. Returns the hit count.
+size_t hexSearchTag256(const HexSearch_t *s, const uint8_t *buf, size_t len,
+                       ANSIColorMap256_t *colorMap, ANSIErrTagMap256_t *errMap);
+
+// Check the CRC of bytes [begin, begin + len) against the (width + 7) / 8 byte
+// trailer at offset trailer. On a mismatch the region is tagged WAN and the
+// trailer ERR (clipped to the map). Returns 1 match, 0 mismatch, -1 when the
+// region or trailer lies outside the frame.
+int hexCrcTag256(const crc_t *crc, const uint8_t *buf, size_t buf_len, size_t begin, size_t len,
+                 size_t trailer, bool bigEndian, ANSIErrTagMap256_t *errMap);
+int hexCrcTag256v(const crc_t *crc, const HexSeg_t *segs, size_t nsegs, size_t begin, size_t len,
+                  size_t trailer, bool bigEndian, ANSIErrTagMap256_t *errMap);
+
+// maxBytes bounds the cached output plus per-entry overhead (the key, about
+// 1 KiB with maps); least recently used entries are evicted to make room.
+// Entries are keyed by the bytes, maps, title and tail, colour strings by
+// content, and a hit is only served when the whole key matches.
+HexCache_t *hexCacheNew(size_t maxBytes);
+void hexCacheFree(HexCache_t *cache);
+void hexCacheClear(HexCache_t *cache);
+void hexCacheStats(HexCache_t *cache, HexCacheStats_t *out);
+// Same arguments and output as the renderers, served from the cache when
+// possible; release the result with utlFree(). A NULL cache just renders.
+char* hexCacheTable256(HexCache_t *cache, uint8_t *buffer, size_t buffer_len, const char *title_str, const char *tail_str);
+char* hexCacheColorTable256(HexCache_t *cache, uint8_t *buffer, size_t buffer_len, ANSIColorMap256_t *ansiMap,
+                            ANSIErrTagMap256_t *errMap, const char *title_str, const char *tail_str);
+// Writes the table to out without an intermediate copy on a hit; returns the
+// number of bytes written, or -1.
+long hexCacheFputColorTable256(HexCache_t *cache, FILE *out, uint8_t *buffer, size_t buffer_len,
+                               ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap,
+                               const char *title_str, const char *tail_str);
+
+// Opens path for appending, creating it if needed; bufBytes (0: 64 KiB) is the
+// write buffer. Entries reach the file when the buffer fills, on flush and on
+// close. A writer is not thread safe. Each distinct title and colour string
+// is stored once per journal, with no limit on how many there are. A record
+// torn at the end of an existing journal is cut off; if a record before that
+// is corrupt the open fails and the file is not modified.
+HexJournal_t *hexJournalOpen(const char *path, size_t bufBytes);
+// Returns 0, or -1 on bad arguments, out of memory or a failed write.
+int hexJournalAppend(HexJournal_t *journal, uint64_t timestamp, const uint8_t *buffer, size_t buffer_len,
+                     const HexJournalRange_t *ranges, size_t nranges, const char *title_str);
+// Same, taking the maps printColorHexTable256() takes (either may be NULL).
+int hexJournalAppendMaps(HexJournal_t *journal, uint64_t timestamp, const uint8_t *buffer, size_t buffer_len,
+                         const ANSIColorMap256_t *ansiMap, const ANSIErrTagMap256_t *errMap, const char *title_str);
+int hexJournalFlush(HexJournal_t *journal);
+int hexJournalClose(HexJournal_t *journal);
+
+// Indexes the entries present when it is opened; a torn last record is ignored
+// and a corrupt one further in makes the open fail.
+HexJournalReader_t *hexJournalReaderOpen(const char *path);
+void hexJournalReaderClose(HexJournalReader_t *reader);
+size_t hexJournalCount(const HexJournalReader_t *reader);
+const HexJournalEntry_t *hexJournalGet(HexJournalReader_t *reader, size_t index);
+// Rebuilds the maps an entry was recorded with (either may be NULL).
+void hexJournalEntryMaps(const HexJournalEntry_t *entry, ANSIColorMap256_t *ansiMap, ANSIErrTagMap256_t *errMap);
+// Renders entry index with its recorded title, through printColorHexTable256()
+// or, without colour, printHexTable256(); release the result with utlFree().
+char* hexJournalRender(HexJournalReader_t *reader, size_t index, bool color, const char *tail_str);
+
 void addr2AnsiColorMap256(ANSIColorMap256_t *colorMap, uint8_t colorAddrBegin, uint8_t colorAddrEnd, 
                           const char *colorStr,
                           uint8_t charAddrBegin, char charBegin,
@@ -0,0 +1,189 @@
+/*
+ * File:        printfUtils/allocutl.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Library-wide allocator hook and a bump arena.
+ *
+ *    Every heap request made by sappendf() and the printHexTable renderers goes
+ *    through utlAlloc() / utlRealloc() / utlFree(), which use the calling
+ *    thread's override if one is set, otherwise the process-wide allocator,
+ *    otherwise libc. Installing a per-thread arena keeps rendering threads off
+ *    the shared heap entirely and lets a whole frame be released with one
+ *    utlArenaReset().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "printfutl.h"
+
+// Arena blocks carry their size in a header; 16 keeps payloads aligned for any scalar type.
+#define ARENA_ALIGN 16
+#define ARENA_HDR   ARENA_ALIGN
+
+static void *libc_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void *libc_realloc(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    return realloc(ptr, size);
+}
+
+static void libc_free(void *ctx, void *ptr) {
+    (void)ctx;
+    free(ptr);
+}
+
+static const utl_allocator_t LIBC_ALLOCATOR = { libc_alloc, libc_realloc, libc_free, NULL };
+
+static const utl_allocator_t *global_allocator = &LIBC_ALLOCATOR;
+static __thread const utl_allocator_t *thread_allocator = NULL;
+
+static inline const utl_allocator_t *current_allocator(void) {
+    const utl_allocator_t *a = thread_allocator;
+    return a ? a : __atomic_load_n(&global_allocator, __ATOMIC_ACQUIRE);
+}
+
+// Internal, for writerutl.c: whether utlFree() on this thread is plain free().
+bool utl_alloc_is_libc(void) {
+    return current_allocator() == &LIBC_ALLOCATOR;
+}
+
+static void __u_T_l_S_e_T_a_L_l_O_c_A_t_O_r__(const utl_allocator_t *allocator) {
+    __atomic_store_n(&global_allocator, allocator ? allocator : &LIBC_ALLOCATOR, __ATOMIC_RELEASE);
+}
+
+static const utl_allocator_t *__u_T_l_S_e_T_t_H_r_E_a_D_a_L_l_O_c_A_t_O_r__(const utl_allocator_t *allocator) {
+    const utl_allocator_t *prev = thread_allocator;
+    thread_allocator = allocator;
+    return prev;
+}
+
+static const utl_allocator_t *__u_T_l_G_e_T_a_L_l_O_c_A_t_O_r__(void) {
+    return current_allocator();
+}
+
+static void *__u_T_l_A_l_L_o_C__(size_t size) {
+    const utl_allocator_t *a = current_allocator();
+    return a->alloc(a->ctx, size);
+}
+
+static void *__u_T_l_R_e_A_l_L_o_C__(void *ptr, size_t size) {
+    const utl_allocator_t *a = current_allocator();
+    return a->realloc(a->ctx, ptr, size);
+}
+
+static void __u_T_l_F_r_E_e__(void *ptr) {
+    if (!ptr) return;
+    const utl_allocator_t *a = current_allocator();
+    a->free(a->ctx, ptr);
+}
+
+
+static inline size_t arena_round(size_t n) {
+    return (n + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+static inline size_t arena_block_size(const uint8_t *p) {
+    size_t size;
+    memcpy(&size, p - ARENA_HDR, sizeof(size));
+    return size;
+}
+
+static inline int arena_is_last(const utl_arena_t *arena, const uint8_t *p) {
+    return arena->last != arena->size && p == arena->base + arena->last + ARENA_HDR;
+}
+
+static void *arena_alloc(void *ctx, size_t size) {
+    utl_arena_t *arena = (utl_arena_t *)ctx;
+    size_t need = ARENA_HDR + arena_round(size);
+    if (size > arena->size || need > arena->size - arena->used) {
+        arena->failed++;
+        return NULL;
+    }
+    uint8_t *hdr = arena->base + arena->used;
+    memcpy(hdr, &size, sizeof(size));
+    arena->last = arena->used;
+    arena->used += need;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return hdr + ARENA_HDR;
+}
+
+static void *arena_realloc(void *ctx, void *ptr, size_t size) {
+    utl_arena_t *arena = (utl_arena_t *)ctx;
+    if (!ptr) return arena_alloc(ctx, size);
+    uint8_t *p = (uint8_t *)ptr;
+    size_t old = arena_block_size(p);
+
+    // The newest block grows (or shrinks) in place: the common sappendf() case.
+    if (arena_is_last(arena, p)) {
+        size_t need = ARENA_HDR + arena_round(size);
+        if (size <= arena->size && need <= arena->size - arena->last) {
+            memcpy(p - ARENA_HDR, &size, sizeof(size));
+            arena->used = arena->last + need;
+            if (arena->used > arena->peak) arena->peak = arena->used;
+            return p;
+        }
+        arena->failed++;
+        return NULL;
+    }
+
+    if (size <= old) {
+        memcpy(p - ARENA_HDR, &size, sizeof(size));
+        return p;
+    }
+    uint8_t *q = (uint8_t *)arena_alloc(ctx, size);
+    if (q) memcpy(q, p, old);
+    return q;
+}
+
+static void arena_free(void *ctx, void *ptr) {
+    utl_arena_t *arena = (utl_arena_t *)ctx;
+    uint8_t *p = (uint8_t *)ptr;
+    if (p && arena_is_last(arena, p)) {
+        arena->used = arena->last;
+        arena->last = arena->size;  // the block before is not tracked
+    }
+}
+
+static void __u_T_l_A_r_E_n_A_i_N_i_T__(utl_arena_t *arena, void *buf, size_t size) {
+    if (!arena) return;
+    // Start the arena on an aligned address.
+    uintptr_t addr = (uintptr_t)buf;
+    size_t skip = (size_t)((ARENA_ALIGN - (addr & (ARENA_ALIGN - 1))) & (ARENA_ALIGN - 1));
+    if (!buf || size < skip) size = skip = 0;
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.realloc = arena_realloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.ctx = arena;
+    arena->base = buf ? (uint8_t *)buf + skip : NULL;
+    arena->size = size - skip;
+    arena->used = 0;
+    arena->last = arena->size;
+    arena->peak = 0;
+    arena->failed = 0;
+}
+
+static void __u_T_l_A_r_E_n_A_r_E_s_E_t__(utl_arena_t *arena) {
+    if (!arena) return;
+    arena->used = 0;
+    arena->last = arena->size;
+}
+
+
+__attribute__((weak, alias("__u_T_l_S_e_T_a_L_l_O_c_A_t_O_r__"))) void utlSetAllocator(const utl_allocator_t *allocator);
+__attribute__((weak, alias("__u_T_l_S_e_T_t_H_r_E_a_D_a_L_l_O_c_A_t_O_r__")))
+const utl_allocator_t *utlSetThreadAllocator(const utl_allocator_t *allocator);
+__attribute__((weak, alias("__u_T_l_G_e_T_a_L_l_O_c_A_t_O_r__"))) const utl_allocator_t *utlGetAllocator(void);
+__attribute__((weak, alias("__u_T_l_A_l_L_o_C__"))) void *utlAlloc(size_t size);
+__attribute__((weak, alias("__u_T_l_R_e_A_l_L_o_C__"))) void *utlRealloc(void *ptr, size_t size);
+__attribute__((weak, alias("__u_T_l_F_r_E_e__"))) void utlFree(void *ptr);
+__attribute__((weak, alias("__u_T_l_A_r_E_n_A_i_N_i_T__"))) void utlArenaInit(utl_arena_t *arena, void *buf, size_t size);
+__attribute__((weak, alias("__u_T_l_A_r_E_n_A_r_E_s_E_t__"))) void utlArenaReset(utl_arena_t *arena);
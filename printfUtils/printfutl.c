@@ -13,6 +13,7 @@
  *    Features:
  *      - `sappendf()` appends printf-style formatted strings to an existing buffer.
  *      - Fallback implementation of `vasprintf()` for libc environments that lack it.
+ *      - Heap use goes through the utlAlloc() hook (see allocutl.c).
  *      - Designed to be compatible with static and weak linking for override flexibility.
  *      - Symbols are designed to be safely used or hidden in embedded/static contexts.
  *
@@ -26,6 +27,8 @@
 #include <string.h>
 #include <stdarg.h>
 #include <stddef.h>
+#include "printfutl.h"
+#include <statUtils/statutl.h>
 
 #if defined(__has_builtin)
     #if __has_builtin(vasprintf)
@@ -43,6 +46,9 @@
 
 
 
+// libc-compatible fallback: the result is released with free(), so it
+// stays on malloc rather than the utlAlloc() hook.
+#if !HAS_VASPRINTF
 static int __v_A_s_P_r_I_n_T_f__(char **strp, const char *fmt, va_list ap) {
     va_list ap_copy;
     va_copy(ap_copy, ap);
@@ -61,41 +67,46 @@ static int __v_A_s_P_r_I_n_T_f__(char **strp, const char *fmt, va_list ap) {
 
     return vsnprintf(*strp, (size_t)len + 1, fmt, ap);
 }
+#endif
+
+
 
+// Appends in place through the allocator hook: one realloc per call and no
+// temporary string. Short results are formatted once into a stack buffer,
+// longer ones are formatted a second time straight into the grown buffer.
+static int sappendf_va(char **buf, const char *fmt, va_list args) {
+    char small[256];
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int len = vsnprintf(small, sizeof(small), fmt, args_copy);
+    va_end(args_copy);
 
+    if (len < 0)
+        return -1; // Format error
+
+    size_t old_len = (*buf) ? strlen(*buf) : 0;
+    char *joined = utlRealloc(*buf, old_len + (size_t)len + 1);
+    if (!joined)
+        return -1; // Allocation failed, *buf is untouched
+    if (*buf) STAT_REALLOC();
+    else STAT_ALLOC();
+
+    if ((size_t)len < sizeof(small))
+        memcpy(joined + old_len, small, (size_t)len + 1); // copy including null terminator
+    else
+        vsnprintf(joined + old_len, (size_t)len + 1, fmt, args);
+    *buf = joined;
+
+    return len;
+}
 
 static int __s_A_p_P_e_N_d_F__(char **buf, const char *fmt, ...) {
+    STAT_SCOPE_BEGIN(scope);
     va_list args;
     va_start(args, fmt);
-
-    // Format the new data
-    char *newstr;
-    int len;
-    #if HAS_VASPRINTF
-    len = vasprintf(&newstr, fmt, args);
-    #else
-    len = __v_A_s_P_r_I_n_T_f__(&newstr, fmt, args);
-    #endif
+    int len = sappendf_va(buf, fmt, args);
     va_end(args);
-
-    if (len < 0 || !newstr)
-        return -1; // Allocation or format error
-
-    // Append it to the old buffer
-    if (*buf) {
-        size_t old_len = strlen(*buf);
-        char *joined = realloc(*buf, old_len + len + 1);
-        if (!joined) {
-            free(newstr);
-            return -1; // realloc failed
-        }
-
-        memcpy(joined + old_len, newstr, len + 1); // copy including null terminator
-        *buf = joined;
-    } else {
-        *buf = newstr;
-    }
-
+    STAT_SCOPE_END(scope, STAT_SAPPENDF, (len > 0) ? len : 0);
     return len;
 }
 
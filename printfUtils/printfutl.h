@@ -5,7 +5,7 @@
  * Licence:     GNU/GPLv3.0
  *
  * Description:
- *    header (function define) for printfutl.c
+ *    header (function define) for printfutl.c, allocutl.c and writerutl.c
  *
  *    Provides portable string formatting utilities for C programs,
  *    including a custom `sappendf()` function that appends formatted text
@@ -15,6 +15,8 @@
  *    Features:
  *      - `sappendf()` appends printf-style formatted strings to an existing buffer.
  *      - Fallback implementation of `vasprintf()` for libc environments that lack it.
+ *      - Pluggable allocator (global or per thread) with a bundled bump arena.
+ *      - Asynchronous batched writer so producers never block on console I/O.
  *      - Designed to be compatible with static and weak linking for override flexibility.
  *      - Symbols are designed to be safely used or hidden in embedded/static contexts.
  *
@@ -30,6 +32,7 @@
 #include <string.h>
 #include <stdarg.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #if defined(__has_builtin)
     #if __has_builtin(vasprintf)
@@ -46,6 +49,49 @@
 #endif
 
 
+// Allocator hook used by sappendf() and the printHexTable renderers.
+// Strings they return must be released with utlFree() (plain free() is
+// fine while the default libc allocator is active).
+typedef struct {
+    void *(*alloc)(void *ctx, size_t size);
+    void *(*realloc)(void *ctx, void *ptr, size_t size);
+    void (*free)(void *ctx, void *ptr);
+    void *ctx;
+} utl_allocator_t;
+
+// Bump arena over a caller-provided buffer: allocation is a pointer bump,
+// free only reclaims the most recent block, utlArenaReset() frees everything.
+// Not thread-safe; give each thread its own arena via utlSetThreadAllocator().
+typedef struct {
+    utl_allocator_t allocator;  // ctx points back at the arena
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    size_t last;                // header offset of the newest block, or size when none
+    size_t peak;                // high-water mark of used since init
+    size_t failed;              // requests that did not fit
+} utl_arena_t;
+
+// What utlWriterSubmit() does when every batch is queued or being written.
+typedef enum {
+    UTL_WRITER_DROP_OLDEST = 0, // discard the oldest queued batch
+    UTL_WRITER_DROP_NEWEST,     // discard the new string
+    UTL_WRITER_SUMMARY          // discard the new string, later write one line counting the drops
+} utl_writer_policy_t;
+
+typedef struct utl_writer utl_writer_t;
+
+typedef struct {
+    uint64_t submitted;
+    uint64_t written;
+    uint64_t dropped;
+    uint64_t failed;            // lost to write errors
+    uint64_t bytes;
+    uint64_t batches;           // writev() batches
+    uint64_t summaries;
+} utl_writer_stats_t;
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -53,6 +99,34 @@ extern "C" {
 
 int sappendf(char **buf, const char *fmt, ...);
 
+// Process-wide allocator; NULL restores malloc/realloc/free. The table must
+// stay valid while installed. A thread override takes precedence and returns
+// the previous override.
+void utlSetAllocator(const utl_allocator_t *allocator);
+const utl_allocator_t *utlSetThreadAllocator(const utl_allocator_t *allocator);
+const utl_allocator_t *utlGetAllocator(void);
+
+void *utlAlloc(size_t size);
+void *utlRealloc(void *ptr, size_t size);
+void utlFree(void *ptr);
+
+void utlArenaInit(utl_arena_t *arena, void *buf, size_t size);
+void utlArenaReset(utl_arena_t *arena);
+
+// Background writer on fd with nbatch (2 or 3) batches of up to batchBytes
+// (0: 64 KiB). utlWriterSubmit() takes ownership of str and returns at once:
+// 0 when queued, -1 when dropped. str must come from the calling thread's
+// current allocator. Under the default libc allocator it is queued as it is
+// and freed by the writer; under any other it is copied (only when there is
+// room) and released with utlFree() before Submit returns, so an arena may
+// be reset right after. Flush waits until everything is written; Close
+// flushes and stops the thread.
+utl_writer_t *utlWriterOpen(int fd, unsigned nbatch, size_t batchBytes, utl_writer_policy_t policy);
+int utlWriterSubmit(utl_writer_t *writer, char *str);
+void utlWriterFlush(utl_writer_t *writer);
+void utlWriterClose(utl_writer_t *writer);
+void utlWriterStats(utl_writer_t *writer, utl_writer_stats_t *out);
+
 #if HAS_VASPRINTF
 int vasprintf(char **strp, const char *fmt, va_list ap);
 #endif
@@ -0,0 +1,341 @@
+/*
+ * File:        printfUtils/writerutl.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Asynchronous batched writer for rendered output.
+ *
+ *    Producers hand strings over by pointer. A string from the libc
+ *    allocator is queued as it is; one from an arena or a custom allocator
+ *    is copied into plain malloc memory once a batch is known to have room,
+ *    and released on the producer's thread with its own allocator, so
+ *    batches never depend on an allocator that may be reset or torn down
+ *    while they wait. Strings are collected into one of two or three
+ *    batches. A background thread takes whole batches and writes them with
+ *    writev(), so a slow UART or a stalled SSH session only ever blocks
+ *    that thread. Producers hold the lock just long enough to append a
+ *    pointer. When every batch is busy the configured policy drops the
+ *    oldest queued batch, drops the new string, or drops it and reports a
+ *    summary line once the writer catches up.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "printfutl.h"
+
+#define WRITER_MAX_BATCHES   3
+#define WRITER_BATCH_MSGS    256
+#define WRITER_BATCH_BYTES   (64 * 1024)
+
+// allocutl.c
+bool utl_alloc_is_libc(void);
+
+typedef struct {
+    char *str;                          // writer-owned, from malloc()
+    size_t len;
+} writer_msg_t;
+
+typedef enum {
+    BATCH_FREE = 0,
+    BATCH_FILLING,
+    BATCH_QUEUED,
+    BATCH_WRITING
+} batch_state_t;
+
+typedef struct {
+    writer_msg_t msg[WRITER_BATCH_MSGS];
+    size_t n;
+    size_t bytes;
+    batch_state_t state;
+    uint64_t seq;                       // queue order
+    uint64_t droppedMsgs, droppedBytes; // summary written ahead of this batch
+} writer_batch_t;
+
+struct utl_writer {
+    int fd;
+    utl_writer_policy_t policy;
+    size_t batchBytes;
+    unsigned nbatch;
+    writer_batch_t batch[WRITER_MAX_BATCHES];
+    int filling;                        // batch producers append to, or -1
+    uint64_t seq;
+    uint64_t summaryMsgs, summaryBytes; // dropped and not yet attached to a batch
+    bool closing;
+    utl_writer_stats_t stats;
+    pthread_mutex_t lock;
+    pthread_cond_t work;                // writer: something to write
+    pthread_cond_t idle;                // flush: a batch was written
+    pthread_t thread;
+};
+
+static void msg_free(writer_msg_t *m) {
+    free(m->str);
+}
+
+// Caller holds the lock.
+static writer_batch_t *oldest_queued(utl_writer_t *w) {
+    writer_batch_t *oldest = NULL;
+    for (unsigned i = 0; i < w->nbatch; i++) {
+        writer_batch_t *b = &w->batch[i];
+        if (b->state == BATCH_QUEUED && (!oldest || b->seq < oldest->seq)) oldest = b;
+    }
+    return oldest;
+}
+
+static void batch_queue(utl_writer_t *w, writer_batch_t *b) {
+    b->state = BATCH_QUEUED;
+    b->seq = ++w->seq;
+    w->filling = -1;
+    pthread_cond_signal(&w->work);
+}
+
+// Whether a string of len bytes would be queued rather than dropped right
+// now; mirrors the batch choice in Submit. Caller holds the lock.
+static bool writer_has_room(utl_writer_t *w, size_t len) {
+    if (w->filling >= 0) {
+        const writer_batch_t *b = &w->batch[w->filling];
+        if (b->n < WRITER_BATCH_MSGS && (!b->n || b->bytes + len <= w->batchBytes)) return true;
+    }
+    for (unsigned i = 0; i < w->nbatch; i++) {
+        if (w->batch[i].state == BATCH_FREE) return true;
+    }
+    return w->policy == UTL_WRITER_DROP_OLDEST && oldest_queued(w);
+}
+
+// Counts a string the writer had no room for. Caller holds the lock.
+static void writer_drop(utl_writer_t *w, size_t len) {
+    w->stats.dropped++;
+    if (w->policy == UTL_WRITER_SUMMARY) {
+        w->summaryMsgs++;
+        w->summaryBytes += len;
+    }
+}
+
+static bool writer_busy(const utl_writer_t *w) {
+    if (w->summaryMsgs) return true;
+    for (unsigned i = 0; i < w->nbatch; i++) {
+        if (w->batch[i].state == BATCH_QUEUED || w->batch[i].state == BATCH_WRITING) return true;
+        if (w->batch[i].state == BATCH_FILLING && w->batch[i].n) return true;
+    }
+    return false;
+}
+
+// writev() everything, resuming after partial writes and EINTR.
+static int write_all(int fd, struct iovec *iov, int cnt) {
+    while (cnt > 0) {
+        ssize_t r = writev(fd, iov, cnt);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        while (cnt > 0 && (size_t)r >= iov->iov_len) {
+            r -= (ssize_t)iov->iov_len;
+            iov++;
+            cnt--;
+        }
+        if (cnt > 0) {
+            iov->iov_base = (char *)iov->iov_base + r;
+            iov->iov_len -= (size_t)r;
+        }
+    }
+    return 0;
+}
+
+static void *writer_main(void *arg) {
+    utl_writer_t *w = (utl_writer_t *)arg;
+    struct iovec iov[WRITER_BATCH_MSGS + 1];
+    char summary[96];
+
+    pthread_mutex_lock(&w->lock);
+    for (;;) {
+        writer_batch_t *b = oldest_queued(w);
+        if (!b && w->filling >= 0 && w->batch[w->filling].n) {
+            // Nothing full yet: take the partial batch rather than wait for it to fill.
+            b = &w->batch[w->filling];
+            w->filling = -1;
+        }
+        uint64_t droppedMsgs = 0, droppedBytes = 0;
+        if (b) {
+            b->state = BATCH_WRITING;
+            droppedMsgs = b->droppedMsgs;
+            droppedBytes = b->droppedBytes;
+        } else if (w->summaryMsgs) {
+            // Drops with nothing submitted after them: report them on their own.
+            droppedMsgs = w->summaryMsgs;
+            droppedBytes = w->summaryBytes;
+            w->summaryMsgs = w->summaryBytes = 0;
+        } else {
+            if (w->closing) break;
+            pthread_cond_wait(&w->work, &w->lock);
+            continue;
+        }
+        if (droppedMsgs) w->stats.summaries++;
+        pthread_mutex_unlock(&w->lock);
+
+        int cnt = 0;
+        if (droppedMsgs) {
+            int len = snprintf(summary, sizeof(summary), "[... %llu message(s), %llu bytes dropped ...]\n",
+                               (unsigned long long)droppedMsgs, (unsigned long long)droppedBytes);
+            iov[cnt++] = (struct iovec){ summary, (size_t)len };
+        }
+        size_t n = b ? b->n : 0;
+        for (size_t i = 0; i < n; i++) iov[cnt++] = (struct iovec){ b->msg[i].str, b->msg[i].len };
+        int rc = write_all(w->fd, iov, cnt);
+        for (size_t i = 0; i < n; i++) msg_free(&b->msg[i]);
+
+        pthread_mutex_lock(&w->lock);
+        if (b) {
+            if (rc == 0) {
+                w->stats.written += n;
+                w->stats.bytes += b->bytes;
+            } else {
+                w->stats.failed += n;
+            }
+            w->stats.batches++;
+            b->n = 0;
+            b->bytes = 0;
+            b->droppedMsgs = b->droppedBytes = 0;
+            b->state = BATCH_FREE;
+        }
+        pthread_cond_broadcast(&w->idle);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+
+static utl_writer_t *__u_T_l_W_r_I_t_E_r_O_p_E_n__(int fd, unsigned nbatch, size_t batchBytes, utl_writer_policy_t policy) {
+    if (fd < 0 || nbatch < 2 || nbatch > WRITER_MAX_BATCHES || (unsigned)policy > UTL_WRITER_SUMMARY) return NULL;
+    utl_writer_t *w = (utl_writer_t *)calloc(1, sizeof(*w));
+    if (!w) return NULL;
+    w->fd = fd;
+    w->nbatch = nbatch;
+    w->batchBytes = batchBytes ? batchBytes : WRITER_BATCH_BYTES;
+    w->policy = policy;
+    w->filling = -1;
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->work, NULL);
+    pthread_cond_init(&w->idle, NULL);
+    if (pthread_create(&w->thread, NULL, writer_main, w) != 0) {
+        pthread_cond_destroy(&w->idle);
+        pthread_cond_destroy(&w->work);
+        pthread_mutex_destroy(&w->lock);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+static int __u_T_l_W_r_I_t_E_r_S_u_B_m_I_t__(utl_writer_t *w, char *str) {
+    if (!str) return -1;
+    if (!w) {
+        utlFree(str);
+        return -1;
+    }
+    writer_msg_t m = { str, strlen(str) };
+    if (!utl_alloc_is_libc()) {
+        // Not ours to free() later: copy, but only once a batch has room for it.
+        pthread_mutex_lock(&w->lock);
+        if (!writer_has_room(w, m.len)) {
+            w->stats.submitted++;
+            writer_drop(w, m.len);
+            pthread_mutex_unlock(&w->lock);
+            utlFree(str);
+            return -1;
+        }
+        pthread_mutex_unlock(&w->lock);
+        m.str = (char *)malloc(m.len ? m.len : 1);
+        if (m.str) memcpy(m.str, str, m.len);
+        utlFree(str);
+    }
+
+    pthread_mutex_lock(&w->lock);
+    w->stats.submitted++;
+    if (!m.str) {
+        w->stats.dropped++;
+        pthread_mutex_unlock(&w->lock);
+        return -1;
+    }
+    writer_batch_t *b = (w->filling >= 0) ? &w->batch[w->filling] : NULL;
+    if (b && (b->n == WRITER_BATCH_MSGS || (b->n && b->bytes + m.len > w->batchBytes))) {
+        batch_queue(w, b);
+        b = NULL;
+    }
+    if (!b) {
+        for (unsigned i = 0; i < w->nbatch && !b; i++) {
+            if (w->batch[i].state == BATCH_FREE) b = &w->batch[i];
+        }
+        if (!b && w->policy == UTL_WRITER_DROP_OLDEST && (b = oldest_queued(w))) {
+            for (size_t i = 0; i < b->n; i++) msg_free(&b->msg[i]);
+            w->stats.dropped += b->n;
+            b->n = 0;
+            b->bytes = 0;
+        }
+        if (!b) {
+            // Writer is behind and the policy keeps what is queued.
+            writer_drop(w, m.len);
+            pthread_mutex_unlock(&w->lock);
+            msg_free(&m);
+            return -1;
+        }
+        b->state = BATCH_FILLING;
+        b->droppedMsgs = w->summaryMsgs;
+        b->droppedBytes = w->summaryBytes;
+        w->summaryMsgs = w->summaryBytes = 0;
+        w->filling = (int)(b - w->batch);
+    }
+    b->msg[b->n++] = m;
+    b->bytes += m.len;
+    if (b->n == 1) pthread_cond_signal(&w->work);
+    pthread_mutex_unlock(&w->lock);
+    return 0;
+}
+
+static void __u_T_l_W_r_I_t_E_r_F_l_U_s_H__(utl_writer_t *w) {
+    if (!w) return;
+    pthread_mutex_lock(&w->lock);
+    pthread_cond_signal(&w->work);
+    while (writer_busy(w)) pthread_cond_wait(&w->idle, &w->lock);
+    pthread_mutex_unlock(&w->lock);
+}
+
+static void __u_T_l_W_r_I_t_E_r_C_l_O_s_E__(utl_writer_t *w) {
+    if (!w) return;
+    pthread_mutex_lock(&w->lock);
+    w->closing = true;
+    pthread_cond_signal(&w->work);
+    pthread_mutex_unlock(&w->lock);
+    pthread_join(w->thread, NULL);   // the writer drains every batch before it exits
+    pthread_cond_destroy(&w->idle);
+    pthread_cond_destroy(&w->work);
+    pthread_mutex_destroy(&w->lock);
+    free(w);
+}
+
+static void __u_T_l_W_r_I_t_E_r_S_t_A_t_S__(utl_writer_t *w, utl_writer_stats_t *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!w) return;
+    pthread_mutex_lock(&w->lock);
+    *out = w->stats;
+    pthread_mutex_unlock(&w->lock);
+}
+
+
+__attribute__((weak, alias("__u_T_l_W_r_I_t_E_r_O_p_E_n__")))
+utl_writer_t *utlWriterOpen(int fd, unsigned nbatch, size_t batchBytes, utl_writer_policy_t policy);
+__attribute__((weak, alias("__u_T_l_W_r_I_t_E_r_S_u_B_m_I_t__"))) int utlWriterSubmit(utl_writer_t *writer, char *str);
+__attribute__((weak, alias("__u_T_l_W_r_I_t_E_r_F_l_U_s_H__"))) void utlWriterFlush(utl_writer_t *writer);
+__attribute__((weak, alias("__u_T_l_W_r_I_t_E_r_C_l_O_s_E__"))) void utlWriterClose(utl_writer_t *writer);
+__attribute__((weak, alias("__u_T_l_W_r_I_t_E_r_S_t_A_t_S__"))) void utlWriterStats(utl_writer_t *writer, utl_writer_stats_t *out);
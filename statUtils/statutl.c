@@ -0,0 +1,241 @@
+/*
+ * File:        statUtils/statutl.c
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    Per-thread counters behind the STAT_* probes (see statutl.h).
+ *
+ *    Each thread owns a block that only it writes, with relaxed atomic
+ *    stores, so probes never contend. Blocks are linked into a registry when
+ *    first used; a pthread key destructor folds a block into the retired
+ *    totals when its thread exits. Resets store a baseline instead of
+ *    clearing other threads' counters.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "statutl.h"
+
+static const char *STAT_NAMES[STAT_COUNT] = {
+    "sappendf",
+    "printHexTable256",
+    "printColorHexTable256",
+    "hsv2rgb_batch",
+    "hsl2rgb_batch",
+    "rgb2hsv_batch",
+    "rgb2hsl_batch",
+    "colormapRow",
+    "pixconv",
+    "compositeSpan",
+    "hexSearchScan",
+    "hsv8_2rgb_batch",
+    "hsl8_2rgb_batch",
+    "hexJournalAppend",
+    "paletteMap",
+};
+
+#if defined(RADIO_UTILS_STATS)
+
+typedef struct stat_block {
+    stat_counter_t c[STAT_COUNT];
+    uint64_t allocs;            // running totals, attributed to scopes on exit
+    uint64_t reallocs;
+    stat_snapshot_t base;       // statResetThread() baseline, owner only
+    struct stat_block *prev, *next;
+} stat_block_t;
+
+static pthread_mutex_t stat_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t stat_once = PTHREAD_ONCE_INIT;
+static pthread_key_t stat_key;
+static stat_block_t *stat_live = NULL;
+static stat_snapshot_t stat_retired;
+static stat_snapshot_t stat_base;
+static __thread stat_block_t *stat_tls = NULL;
+
+#define STAT_LOAD(x)      __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STAT_ADD(x, v)    __atomic_store_n(&(x), STAT_LOAD(x) + (v), __ATOMIC_RELAXED)
+
+static void stat_accumulate(stat_snapshot_t *dst, const stat_counter_t *c) {
+    for (int i = 0; i < STAT_COUNT; i++) {
+        dst->c[i].calls    += STAT_LOAD(c[i].calls);
+        dst->c[i].bytes    += STAT_LOAD(c[i].bytes);
+        dst->c[i].allocs   += STAT_LOAD(c[i].allocs);
+        dst->c[i].reallocs += STAT_LOAD(c[i].reallocs);
+        dst->c[i].ns       += STAT_LOAD(c[i].ns);
+    }
+}
+
+static void stat_subtract(stat_snapshot_t *dst, const stat_snapshot_t *base) {
+    for (int i = 0; i < STAT_COUNT; i++) {
+        dst->c[i].calls    -= base->c[i].calls;
+        dst->c[i].bytes    -= base->c[i].bytes;
+        dst->c[i].allocs   -= base->c[i].allocs;
+        dst->c[i].reallocs -= base->c[i].reallocs;
+        dst->c[i].ns       -= base->c[i].ns;
+    }
+}
+
+// Totals since process start; caller holds stat_lock.
+static void stat_total_locked(stat_snapshot_t *out) {
+    *out = stat_retired;
+    for (stat_block_t *b = stat_live; b; b = b->next) stat_accumulate(out, b->c);
+}
+
+static void stat_thread_exit(void *arg) {
+    stat_block_t *b = (stat_block_t *)arg;
+    pthread_mutex_lock(&stat_lock);
+    stat_accumulate(&stat_retired, b->c);
+    if (b->prev) b->prev->next = b->next;
+    else stat_live = b->next;
+    if (b->next) b->next->prev = b->prev;
+    pthread_mutex_unlock(&stat_lock);
+    stat_tls = NULL;
+    free(b);
+}
+
+static void stat_key_init(void) {
+    pthread_key_create(&stat_key, stat_thread_exit);
+}
+
+static stat_block_t *stat_block(void) {
+    stat_block_t *b = stat_tls;
+    if (b) return b;
+
+    pthread_once(&stat_once, stat_key_init);
+    b = (stat_block_t *)calloc(1, sizeof(*b));
+    if (!b) return NULL;
+    pthread_mutex_lock(&stat_lock);
+    b->next = stat_live;
+    if (stat_live) stat_live->prev = b;
+    stat_live = b;
+    pthread_mutex_unlock(&stat_lock);
+    pthread_setspecific(stat_key, b);
+    stat_tls = b;
+    return b;
+}
+
+static uint64_t stat_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void __s_T_a_T_s_C_o_P_e_B_e_G_i_N__(stat_scope_t *scope) {
+    stat_block_t *b = stat_block();
+    scope->allocs = b ? STAT_LOAD(b->allocs) : 0;
+    scope->reallocs = b ? STAT_LOAD(b->reallocs) : 0;
+    scope->t0 = stat_now_ns();
+}
+
+static void __s_T_a_T_s_C_o_P_e_E_n_D__(stat_scope_t *scope, stat_id_t id, uint64_t bytes) {
+    uint64_t t1 = stat_now_ns();
+    stat_block_t *b = stat_block();
+    if (!b || (unsigned)id >= STAT_COUNT) return;
+    stat_counter_t *c = &b->c[id];
+    STAT_ADD(c->calls, 1);
+    STAT_ADD(c->bytes, bytes);
+    STAT_ADD(c->allocs, STAT_LOAD(b->allocs) - scope->allocs);
+    STAT_ADD(c->reallocs, STAT_LOAD(b->reallocs) - scope->reallocs);
+    STAT_ADD(c->ns, t1 - scope->t0);
+}
+
+static void __s_T_a_T_c_O_u_N_t_A_l_L_o_C__(void) {
+    stat_block_t *b = stat_block();
+    if (b) STAT_ADD(b->allocs, 1);
+}
+
+static void __s_T_a_T_c_O_u_N_t_R_e_A_l_L_o_C__(void) {
+    stat_block_t *b = stat_block();
+    if (b) STAT_ADD(b->reallocs, 1);
+}
+
+static int __s_T_a_T_s_N_a_P_s_H_o_T__(stat_snapshot_t *out) {
+    if (!out) return -1;
+    pthread_mutex_lock(&stat_lock);
+    stat_total_locked(out);
+    stat_subtract(out, &stat_base);
+    pthread_mutex_unlock(&stat_lock);
+    return 0;
+}
+
+static int __s_T_a_T_s_N_a_P_s_H_o_T_t_H_r_E_a_D__(stat_snapshot_t *out) {
+    if (!out) return -1;
+    memset(out, 0, sizeof(*out));
+    stat_block_t *b = stat_block();
+    if (!b) return -1;
+    stat_accumulate(out, b->c);
+    stat_subtract(out, &b->base);
+    return 0;
+}
+
+static void __s_T_a_T_r_E_s_E_t__(void) {
+    pthread_mutex_lock(&stat_lock);
+    stat_total_locked(&stat_base);
+    pthread_mutex_unlock(&stat_lock);
+}
+
+static void __s_T_a_T_r_E_s_E_t_T_h_R_e_A_d__(void) {
+    stat_block_t *b = stat_block();
+    if (!b) return;
+    memset(&b->base, 0, sizeof(b->base));
+    stat_accumulate(&b->base, b->c);
+}
+
+static int __s_T_a_T_e_N_a_B_l_E_d__(void) {
+    return 1;
+}
+
+#else // !RADIO_UTILS_STATS: the probes are compiled out, the API reports nothing.
+
+static void __s_T_a_T_s_C_o_P_e_B_e_G_i_N__(stat_scope_t *scope) {
+    (void)scope;
+}
+
+static void __s_T_a_T_s_C_o_P_e_E_n_D__(stat_scope_t *scope, stat_id_t id, uint64_t bytes) {
+    (void)scope; (void)id; (void)bytes;
+}
+
+static void __s_T_a_T_c_O_u_N_t_A_l_L_o_C__(void) {}
+static void __s_T_a_T_c_O_u_N_t_R_e_A_l_L_o_C__(void) {}
+
+static int __s_T_a_T_s_N_a_P_s_H_o_T__(stat_snapshot_t *out) {
+    if (out) memset(out, 0, sizeof(*out));
+    return -1;
+}
+
+static int __s_T_a_T_s_N_a_P_s_H_o_T_t_H_r_E_a_D__(stat_snapshot_t *out) {
+    if (out) memset(out, 0, sizeof(*out));
+    return -1;
+}
+
+static void __s_T_a_T_r_E_s_E_t__(void) {}
+static void __s_T_a_T_r_E_s_E_t_T_h_R_e_A_d__(void) {}
+
+static int __s_T_a_T_e_N_a_B_l_E_d__(void) {
+    return 0;
+}
+
+#endif // RADIO_UTILS_STATS
+
+static const char *__s_T_a_T_n_A_m_E__(stat_id_t id) {
+    return ((unsigned)id < STAT_COUNT) ? STAT_NAMES[id] : "unknown";
+}
+
+
+__attribute__((weak, alias("__s_T_a_T_e_N_a_B_l_E_d__"))) int statEnabled(void);
+__attribute__((weak, alias("__s_T_a_T_n_A_m_E__"))) const char *statName(stat_id_t id);
+__attribute__((weak, alias("__s_T_a_T_s_N_a_P_s_H_o_T__"))) int statSnapshot(stat_snapshot_t *out);
+__attribute__((weak, alias("__s_T_a_T_s_N_a_P_s_H_o_T_t_H_r_E_a_D__"))) int statSnapshotThread(stat_snapshot_t *out);
+__attribute__((weak, alias("__s_T_a_T_r_E_s_E_t__"))) void statReset(void);
+__attribute__((weak, alias("__s_T_a_T_r_E_s_E_t_T_h_R_e_A_d__"))) void statResetThread(void);
+__attribute__((weak, alias("__s_T_a_T_s_C_o_P_e_B_e_G_i_N__"))) void statScopeBegin(stat_scope_t *scope);
+__attribute__((weak, alias("__s_T_a_T_s_C_o_P_e_E_n_D__"))) void statScopeEnd(stat_scope_t *scope, stat_id_t id, uint64_t bytes);
+__attribute__((weak, alias("__s_T_a_T_c_O_u_N_t_A_l_L_o_C__"))) void statCountAlloc(void);
+__attribute__((weak, alias("__s_T_a_T_c_O_u_N_t_R_e_A_l_L_o_C__"))) void statCountRealloc(void);
@@ -0,0 +1,106 @@
+/*
+ * File:        statUtils/statutl.h
+ * Author:      KaliAssistant <work.kaliassistant.github@gmail.com>
+ * URL:         https://github.com/KaliAssistant/Radio_Utils
+ * Licence:     GNU/GPLv3.0
+ *
+ * Description:
+ *    header (function define) for statutl.c
+ *
+ *    Opt-in runtime counters for the Radio_Utils libraries. Each instrumented
+ *    entry point records calls, bytes produced, heap allocations and
+ *    reallocations, and wall-clock nanoseconds. Counters are kept per thread
+ *    and summed on demand, so recording never takes a lock.
+ *
+ *    Build the libraries with RADIO_UTILS_STATS defined (`make STATS=1`) to
+ *    compile the probes in. Without it the STAT_* macros expand to nothing;
+ *    the snapshot API still links, returns -1 and reports zeros.
+ *
+ *    All columns are inclusive: a renderer's allocations and time include the
+ *    sappendf() calls it makes, which are also counted under STAT_SAPPENDF.
+ */
+
+#ifndef STATUTL_H
+#define STATUTL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum {
+    STAT_SAPPENDF = 0,
+    STAT_HEXTABLE256,
+    STAT_COLORHEXTABLE256,
+    STAT_HSV2RGB_BATCH,
+    STAT_HSL2RGB_BATCH,
+    STAT_RGB2HSV_BATCH,
+    STAT_RGB2HSL_BATCH,
+    STAT_COLORMAP_ROW,
+    STAT_PIXCONV,
+    STAT_COMPOSITE_SPAN,
+    STAT_HEXSEARCH,
+    STAT_HSV8_2RGB_BATCH,
+    STAT_HSL8_2RGB_BATCH,
+    STAT_HEXJOURNAL_APPEND,
+    STAT_PALETTE_MAP,
+    STAT_COUNT
+} stat_id_t;
+
+typedef struct {
+    uint64_t calls;
+    uint64_t bytes;     // bytes produced (string length, output pixels / floats)
+    uint64_t allocs;    // malloc / calloc
+    uint64_t reallocs;
+    uint64_t ns;        // cumulative wall-clock time
+} stat_counter_t;
+
+typedef struct {
+    stat_counter_t c[STAT_COUNT];
+} stat_snapshot_t;
+
+// Probe state on the caller's stack.
+typedef struct {
+    uint64_t t0;
+    uint64_t allocs;
+    uint64_t reallocs;
+} stat_scope_t;
+
+
+#if defined(RADIO_UTILS_STATS)
+#define STAT_SCOPE_BEGIN(scope)          stat_scope_t scope; statScopeBegin(&scope)
+#define STAT_SCOPE_END(scope, id, bytes) statScopeEnd(&scope, (id), (uint64_t)(bytes))
+#define STAT_ALLOC()                     statCountAlloc()
+#define STAT_REALLOC()                   statCountRealloc()
+#else
+#define STAT_SCOPE_BEGIN(scope)          ((void)0)
+#define STAT_SCOPE_END(scope, id, bytes) ((void)0)
+#define STAT_ALLOC()                     ((void)0)
+#define STAT_REALLOC()                   ((void)0)
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 1 when the library was built with RADIO_UTILS_STATS.
+int statEnabled(void);
+const char *statName(stat_id_t id);
+
+// Totals over all threads (live and exited) since the last statReset().
+int statSnapshot(stat_snapshot_t *out);
+// The calling thread's totals since its last statResetThread().
+int statSnapshotThread(stat_snapshot_t *out);
+void statReset(void);
+void statResetThread(void);
+
+// Used by the STAT_* macros.
+void statScopeBegin(stat_scope_t *scope);
+void statScopeEnd(stat_scope_t *scope, stat_id_t id, uint64_t bytes);
+void statCountAlloc(void);
+void statCountRealloc(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STATUTL_H
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <printfUtils/printfutl.h>
+#include <printHexTable/printHexTable.h>
+#include "testutil.h"
+
+#define THREADS 4
+
+static uint8_t frame[256];
+static char *reference;
+
+// Counting wrapper around libc, installed process-wide.
+static size_t calls;
+static void *count_alloc(void *ctx, size_t size) { (void)ctx; __atomic_add_fetch(&calls, 1, __ATOMIC_RELAXED); return malloc(size); }
+static void *count_realloc(void *ctx, void *p, size_t size) { (void)ctx; __atomic_add_fetch(&calls, 1, __ATOMIC_RELAXED); return realloc(p, size); }
+static void count_free(void *ctx, void *p) { (void)ctx; free(p); }
+static const utl_allocator_t COUNTING = { count_alloc, count_realloc, count_free, NULL };
+
+static void *render_worker(void *arg) {
+    (void)arg;
+    static __thread uint8_t pool[64 * 1024];
+    utl_arena_t arena;
+    utlArenaInit(&arena, pool, sizeof(pool));
+    utlSetThreadAllocator(&arena.allocator);
+    for (int i = 0; i < 50; i++) {
+        char *s = printHexTable256(frame, sizeof(frame), "arena", "tail");
+        if (!s || strcmp(s, reference) != 0) {
+            printf("thread render %d differs\n", i);
+            __atomic_add_fetch(&fail, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        utlArenaReset(&arena);
+    }
+    utlSetThreadAllocator(NULL);
+    return (void *)(uintptr_t)arena.failed;
+}
+
+int main(void) {
+    for (int i = 0; i < 256; i++) frame[i] = (uint8_t)(i * 13);
+    reference = printHexTable256(frame, sizeof(frame), "arena", "tail");
+
+    // Arena basics: the newest block grows in place, older ones move.
+    static uint8_t pool[4096];
+    utl_arena_t arena;
+    utlArenaInit(&arena, pool + 1, sizeof(pool) - 1);   // misaligned on purpose
+    const utl_allocator_t *a = &arena.allocator;
+    char *p = a->alloc(a->ctx, 10);
+    CHECK(((uintptr_t)p & 15) == 0, "arena block not aligned");
+    char *q = a->realloc(a->ctx, p, 100);
+    CHECK(q == p, "newest block did not grow in place");
+    char *r = a->alloc(a->ctx, 5);
+    strcpy(q, "kept");
+    char *q2 = a->realloc(a->ctx, q, 200);
+    CHECK(q2 != q && strcmp(q2, "kept") == 0, "older block was not moved");
+    a->free(a->ctx, q2);
+    size_t used = arena.used;
+    char *q3 = a->alloc(a->ctx, 200);
+    CHECK(q3 == q2 && arena.used == used + 16 + 208, "freeing the newest block did not roll back");
+    (void)r;
+    CHECK(a->alloc(a->ctx, 8192) == NULL && arena.failed == 1, "oversized request not rejected");
+    utlArenaReset(&arena);
+    CHECK(arena.used == 0 && arena.peak > 0, "reset");
+
+    // sappendf through a thread override, and out-of-memory leaves the buffer intact.
+    utlArenaInit(&arena, pool, 64);
+    utlSetThreadAllocator(&arena.allocator);
+    char *s = NULL;
+    CHECK(sappendf(&s, "%s-%d", "abc", 42) == 6 && strcmp(s, "abc-42") == 0, "sappendf in arena");
+    CHECK((uint8_t *)s >= pool && (uint8_t *)s < pool + sizeof(pool), "sappendf ignored the thread allocator");
+    CHECK(sappendf(&s, "%0100d", 1) == -1 && strcmp(s, "abc-42") == 0, "sappendf overflow");
+    utlSetThreadAllocator(NULL);
+    CHECK(utlGetAllocator() != &arena.allocator, "thread override not cleared");
+
+    // Long output is formatted straight into the destination.
+    char *big = NULL;
+    char pad[1000];
+    memset(pad, 'x', sizeof(pad) - 1);
+    pad[sizeof(pad) - 1] = '\0';
+    CHECK(sappendf(&big, "<%s>", pad) == 1001 && big[0] == '<' && big[1000] == '>' && big[1001] == '\0', "long sappendf");
+    utlFree(big);
+
+    // The process-wide hook sees the renderer's requests.
+    utlSetAllocator(&COUNTING);
+    char *t = printColorHexTable256(frame, 200, NULL, NULL, "hook", NULL);
+    CHECK(calls > 0, "global allocator not used");
+    utlFree(t);
+    utlSetAllocator(NULL);
+
+    // Per-thread arenas: identical output, one reset per frame.
+    pthread_t th[THREADS];
+    for (int i = 0; i < THREADS; i++) pthread_create(&th[i], NULL, render_worker, NULL);
+    for (int i = 0; i < THREADS; i++) {
+        void *failed;
+        pthread_join(th[i], &failed);
+        CHECK((uintptr_t)failed == 0, "thread arena ran out of space");
+    }
+
+    free(reference);
+    return test_report("allocutl");
+}
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+#define N 4099  // not a multiple of the SIMD width, so the scalar tail runs too
+#define TOL 1e-5f
+
+static float a[N], b[N], c[N];
+static float x[N], y[N], z[N];
+
+static float frand(void) {
+    return (float)rand() / (float)RAND_MAX;
+}
+
+static int check(const char *name, int i, float got, float want) {
+    if (fabsf(got - want) > TOL) {
+        printf("%s[%d]: got %f want %f\n", name, i, got, want);
+        return 1;
+    }
+    return 0;
+}
+
+// Hue is circular: 0 and 360 are the same color.
+static int checkHue(const char *name, int i, float got, float want) {
+    float d = fabsf(got - want);
+    if (d > 180.0f) d = 360.0f - d;
+    return check(name, i, d, 0.0f);
+}
+
+static int in01(float x) {
+    return x >= 0.0f && x <= 1.0f;
+}
+
+// Hues far outside one turn: exact turns away from a base hue give its colour
+// while float still has the precision, anything finite gives an in-range
+// colour, and NaN / Inf hues read as 0. The SIMD body and the scalar tail
+// (n = 1) agree on all of them.
+static void check_hue_range(void) {
+    enum { M = 24 };
+    static const float HUGE_H[] = { 2147483648.0f, -2147483648.0f, 3e9f, -3e9f, 1e30f, -1e30f, 8388609.0f, -16777217.0f };
+    float h[M], s[M], v[M], r[M], g[M], bl[M];
+    for (int hsl = 0; hsl < 2; hsl++) {
+        void (*conv)(const float *, const float *, const float *, float *, float *, float *, size_t) =
+            hsl ? hsl2rgb_batch : hsv2rgb_batch;
+        const char *name = hsl ? "hsl2rgb" : "hsv2rgb";
+        for (int i = 0; i < M; i++) {
+            s[i] = 0.8f;
+            v[i] = 0.6f;
+            h[i] = (i < 8) ? 37.5f + 360.0f * (float)(i * 311 - 1100) : HUGE_H[i % 8];
+        }
+        h[16] = NAN;
+        h[17] = INFINITY;
+        h[18] = -INFINITY;
+        conv(h, s, v, r, g, bl, M);
+        float r0, g0, b0, rz, gz, bz, zero = 0.0f;
+        conv(&h[0], &s[0], &v[0], &r0, &g0, &b0, 1);
+        conv(&zero, &s[0], &v[0], &rz, &gz, &bz, 1);
+        for (int i = 0; i < M; i++) {
+            float r1, g1, b1;
+            conv(&h[i], &s[i], &v[i], &r1, &g1, &b1, 1);
+            CHECK(in01(r[i]) && in01(g[i]) && in01(bl[i]), "%s(%g): out of range %g %g %g", name, h[i], r[i], g[i], bl[i]);
+            if (i < 8) {
+                CHECK(fabsf(r[i] - r0) < 1e-3f && fabsf(g[i] - g0) < 1e-3f && fabsf(bl[i] - b0) < 1e-3f,
+                      "%s(%g): not a whole number of turns from 37.5", name, h[i]);
+            }
+            if (i >= 16 && i <= 18) {
+                CHECK(r[i] == rz && g[i] == gz && bl[i] == bz && r1 == rz && g1 == gz && b1 == bz,
+                      "%s(%g): not read as 0", name, h[i]);
+            }
+        }
+    }
+}
+
+int main(void) {
+    int rc = test_each_cpu_level();
+    if (rc >= 0) return rc;
+    srand(1);
+
+    for (int i = 0; i < N; i++) {
+        a[i] = frand() * 720.0f;
+        b[i] = frand() * 1.2f - 0.1f;
+        c[i] = frand() * 1.2f - 0.1f;
+    }
+    // Exact sector boundaries and grays.
+    for (int i = 0; i < 13; i++) { a[i] = i * 60.0f; b[i] = 1.0f; c[i] = 1.0f; }
+    b[13] = 0.0f; c[14] = 0.0f;
+
+    hsv2rgb_batch(a, b, c, x, y, z, N);
+    for (int i = 0; i < N; i++) {
+        float r, g, bl;
+        hsv2rgb(a[i], b[i], c[i], &r, &g, &bl);
+        fail += check("hsv2rgb.r", i, x[i], r) + check("hsv2rgb.g", i, y[i], g) + check("hsv2rgb.b", i, z[i], bl);
+    }
+
+    hsl2rgb_batch(a, b, c, x, y, z, N);
+    for (int i = 0; i < N; i++) {
+        float r, g, bl;
+        hsl2rgb(a[i], b[i], c[i], &r, &g, &bl);
+        fail += check("hsl2rgb.r", i, x[i], r) + check("hsl2rgb.g", i, y[i], g) + check("hsl2rgb.b", i, z[i], bl);
+    }
+
+    for (int i = 0; i < N; i++) {
+        a[i] = frand(); b[i] = frand(); c[i] = frand();
+    }
+    a[0] = b[0] = c[0] = 0.0f;
+    a[1] = b[1] = c[1] = 0.5f;
+    a[2] = 1.0f; b[2] = 1.0f; c[2] = 0.0f;
+    a[3] = 0.0f; b[3] = 1.0f; c[3] = 1.0f;
+
+    rgb2hsv_batch(a, b, c, x, y, z, N);
+    for (int i = 0; i < N; i++) {
+        float h, s, v;
+        rgb2hsv(a[i], b[i], c[i], &h, &s, &v);
+        fail += checkHue("rgb2hsv.h", i, x[i], h) + check("rgb2hsv.s", i, y[i], s) + check("rgb2hsv.v", i, z[i], v);
+    }
+
+    rgb2hsl_batch(a, b, c, x, y, z, N);
+    for (int i = 0; i < N; i++) {
+        float h, s, l;
+        rgb2hsl(a[i], b[i], c[i], &h, &s, &l);
+        fail += checkHue("rgb2hsl.h", i, x[i], h) + check("rgb2hsl.s", i, y[i], s) + check("rgb2hsl.l", i, z[i], l);
+    }
+
+    check_hue_range();
+
+    char name[32];
+    snprintf(name, sizeof(name), "colorBatch [%s]", cpuLevelName(cpuLevel()));
+    return test_report(name);
+}
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+#define MAXN 200   // past three 64-sample chunks, so every tail length shows up
+
+static const char *OUTS[] = { "RGB565", "RGB888", "ANSI256" };
+
+// The documented mapping: clamp((x - min) * scale + 0.5, 0, size - 1), NaN -> 0.
+static uint16_t ref_index(const colormap_t *cm, float x) {
+    float t = (x - cm->min) * cm->scale + 0.5f;
+    if (!(t > 0)) return 0;
+    if (t > (float)(cm->size - 1)) return (uint16_t)(cm->size - 1);
+    return (uint16_t)t;
+}
+
+// Checks n output pixels against the palette entries of the reference indices.
+static void check_row(const char *what, const colormap_t *cm, colormap_out_t out, const void *dst, const float *x,
+                      size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint16_t k = ref_index(cm, x[i]);
+        int ok;
+        if (out == COLORMAP_RGB565) ok = ((const uint16_t *)dst)[i] == cm->rgb565[k];
+        else if (out == COLORMAP_RGB888) ok = memcmp((const uint8_t *)dst + 3 * i, cm->rgb888[k], 3) == 0;
+        else ok = ((const uint8_t *)dst)[i] == cm->ansi256[k];
+        if (!ok) {
+            CHECK(0, "%s %s n=%zu [%zu]: x=%g want entry %u", what, OUTS[out], n, i, x[i], k);
+            return;
+        }
+    }
+}
+
+// Every input type, output format and length 1..MAXN against the reference;
+// the vector body and the scalar tail split differently at each length.
+static void check_rows(const colormap_t *cm) {
+    static float xf[MAXN], xi16[MAXN], xi8[MAXN];
+    static float f32[MAXN];
+    static int16_t i16[MAXN];
+    static int8_t i8[MAXN];
+    static uint8_t dst[MAXN * 3 + 16];
+    for (int i = 0; i < MAXN; i++) {
+        f32[i] = cm->min + (cm->max - cm->min) * ((float)rand() / RAND_MAX * 1.4f - 0.2f);
+        i16[i] = (int16_t)(rand() & 0xFFFF);
+        i8[i] = (int8_t)(rand() & 0xFF);
+    }
+    f32[3] = NAN;
+    f32[17] = INFINITY;
+    f32[18] = -INFINITY;
+    f32[40] = cm->min;
+    f32[41] = cm->max;
+    i16[5] = INT16_MIN;
+    i16[6] = INT16_MAX;
+    i8[7] = INT8_MIN;
+    i8[8] = INT8_MAX;
+    for (int i = 0; i < MAXN; i++) {
+        xf[i] = f32[i];
+        xi16[i] = (float)i16[i];
+        xi8[i] = (float)i8[i];
+    }
+    for (int out = COLORMAP_RGB565; out <= COLORMAP_ANSI256; out++) {
+        for (size_t n = 1; n <= MAXN; n++) {
+            memset(dst, 0xA5, sizeof(dst));
+            colormapRowF32(cm, f32, n, (colormap_out_t)out, dst);
+            check_row("f32", cm, (colormap_out_t)out, dst, xf, n);
+            CHECK(dst[n * (out == COLORMAP_RGB888 ? 3 : out == COLORMAP_RGB565 ? 2 : 1)] == 0xA5, "f32 n=%zu overrun", n);
+            colormapRowI16(cm, i16, n, (colormap_out_t)out, dst);
+            check_row("i16", cm, (colormap_out_t)out, dst, xi16, n);
+            colormapRowI8(cm, i8, n, (colormap_out_t)out, dst);
+            check_row("i8", cm, (colormap_out_t)out, dst, xi8, n);
+        }
+    }
+}
+
+int main(void) {
+    int rc = test_each_cpu_level();
+    if (rc >= 0) return rc;
+    srand(11);
+
+    static colormap_t cm;
+    CHECK(colormapInit(&cm, COLORMAP_GRAY, 100, 0, 1) == -1 && colormapInit(NULL, COLORMAP_GRAY, 256, 0, 1) == -1,
+          "bad colormap accepted");
+
+    // Min / max scaling on a gray ramp, where entry k of 256 is gray level k.
+    colormapInit(&cm, COLORMAP_GRAY, 256, -100.0f, 0.0f);
+    float x[] = { -100.0f, 0.0f, -50.0f, -150.0f, 25.0f, -99.9f, -0.2f, NAN, INFINITY, -INFINITY };
+    uint8_t want[] = { 0, 255, 128, 0, 255, 0, 254, 0, 255, 0 };
+    uint8_t rgb[sizeof(x) / sizeof(x[0])][3];
+    colormapRowF32(&cm, x, sizeof(x) / sizeof(x[0]), COLORMAP_RGB888, rgb);
+    for (size_t i = 0; i < sizeof(x) / sizeof(x[0]); i++)
+        CHECK(rgb[i][0] == want[i] && rgb[i][1] == want[i] && rgb[i][2] == want[i], "gray(%g) = %u, want %u", x[i],
+              rgb[i][0], want[i]);
+
+    // A new range rescales without rebuilding; an empty range maps everything to entry 0.
+    colormapSetRange(&cm, 0.0f, 1000.0f);
+    float y[] = { 0.0f, 1000.0f, 500.0f, -1.0f };
+    colormapRowF32(&cm, y, 4, COLORMAP_RGB888, rgb);
+    CHECK(rgb[0][0] == 0 && rgb[1][0] == 255 && rgb[2][0] == 128 && rgb[3][0] == 0, "colormapSetRange");
+    colormapSetRange(&cm, 5.0f, 5.0f);
+    colormapRowF32(&cm, y, 4, COLORMAP_RGB888, rgb);
+    CHECK(cm.scale == 0.0f && rgb[0][0] == 0 && rgb[1][0] == 0, "empty range");
+
+    // Integer inputs use the same float mapping, including their extremes.
+    colormapInit(&cm, COLORMAP_GRAY, 256, -128.0f, 127.0f);
+    int8_t s8[] = { -128, 127, 0, -1 };
+    colormapRowI8(&cm, s8, 4, COLORMAP_RGB888, rgb);
+    CHECK(rgb[0][0] == 0 && rgb[1][0] == 255 && rgb[2][0] == 128 && rgb[3][0] == 127, "int8 scaling");
+
+    static const colormap_kind_t KINDS[] = { COLORMAP_HUE, COLORMAP_VIRIDIS, COLORMAP_GRAY };
+    static const float RANGES[][2] = { { -120.0f, -20.0f }, { -32768.0f, 32767.0f }, { 0.0f, 1.0f }, { 10.0f, 10.0f } };
+    for (int k = 0; k < 3; k++) {
+        for (int size = 256; size <= 1024; size += 768) {
+            for (int r = 0; r < 4; r++) {
+                colormapInit(&cm, KINDS[k], (uint16_t)size, RANGES[r][0], RANGES[r][1]);
+                check_rows(&cm);
+            }
+        }
+    }
+    // The RGB565 entries are the RGB888 ones packed.
+    colormapInit(&cm, COLORMAP_VIRIDIS, 1024, 0, 1);
+    for (int i = 0; i < 1024; i++)
+        CHECK(cm.rgb565[i] == rgb888_2rgb565(cm.rgb888[i][0], cm.rgb888[i][1], cm.rgb888[i][2]), "rgb565[%d]", i);
+
+    char name[32];
+    snprintf(name, sizeof(name), "colormap [%s]", cpuLevelName(cpuLevel()));
+    return test_report(name);
+}
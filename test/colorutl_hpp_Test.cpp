@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <colorUtils/colorutl.hpp>
+#include "testutil.h"
+
+using namespace colorutl;
+
+// Folded at compile time.
+constexpr RGB888 ORANGE{ 255, 165, 0 };
+constexpr RGB565 ORANGE_565 = convert<Format::RGB565>(ORANGE);
+static_assert(ORANGE_565.v == ((0xF8 << 8) | (0xA4 << 3)), "RGB888 -> RGB565");
+static_assert(convert<Format::RGB888>(RGB565{ 0xFFFF }).r == 0xF8, "RGB565 -> RGB888");
+static_assert(convert<Format::RGBA32>(ARGB32{ 0x80112233u }).v == 0x11223380u, "ARGB32 -> RGBA32");
+static_assert(ansi256(RGB888{ 255, 0, 0 }) == 196, "ANSI 256 red");
+static_assert(colorutl::hsv2rgb(450, 1, 1).r == 0.5f && colorutl::hsv2rgb(450, 1, 1).g == 1 &&
+              colorutl::hsv2rgb(450, 1, 1).b == 0, "hue wraps at 360");
+static_assert(composite(PD_SRC_OVER, ARGB32{ 0xFF000000u }, ARGB32{ 0x80800000u }).v == 0xFF800000u, "SRC_OVER");
+
+constexpr Table<uint8_t, 256> GAMMA22 = gammaTable(2.2f);
+static_assert(GAMMA22[0] == 0 && GAMMA22[255] == 255, "gamma table end points");
+
+struct AnsiOfGray {
+    constexpr uint8_t operator()(size_t i) const { return ansi256(Gray8{ (uint8_t)i }); }
+};
+constexpr Table<uint8_t, 256> GRAY_ANSI = makeTable<uint8_t, 256>(AnsiOfGray{});
+static_assert(GRAY_ANSI[255] == 231, "gray palette");
+
+// Equal, or both NaN.
+static bool same(float a, float b) {
+    return a == b || (a != a && b != b);
+}
+
+// Hue outside one turn goes through the same fmodf(h, 360) as the C code,
+// including negative hues, which keep their sign.
+static void check_hue(float h, float s, float v) {
+    float cr, cg, cb;
+    hsv2rgb(h, s, v, &cr, &cg, &cb);
+    RgbF x = colorutl::hsv2rgb(h, s, v);
+    CHECK(same(x.r, cr) && same(x.g, cg) && same(x.b, cb), "hsv2rgb %g %g %g: %g %g %g vs %g %g %g", h, s, v, x.r,
+          x.g, x.b, cr, cg, cb);
+    hsl2rgb(h, s, v, &cr, &cg, &cb);
+    x = colorutl::hsl2rgb(h, s, v);
+    CHECK(same(x.r, cr) && same(x.g, cg) && same(x.b, cb), "hsl2rgb %g %g %g: %g %g %g vs %g %g %g", h, s, v, x.r,
+          x.g, x.b, cr, cg, cb);
+}
+
+static uint32_t rnd32(void) {
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+int main(void) {
+    srand(5);
+
+    for (uint32_t v = 0; v < 0x10000; v++) {
+        uint8_t r, g, b;
+        rgb565_2rgb888((uint16_t)v, &r, &g, &b);
+        RGB888 p = convert<Format::RGB888>(RGB565{ (uint16_t)v });
+        CHECK(p.r == r && p.g == g && p.b == b, "rgb565_2rgb888 %04X", v);
+        CHECK(convert<Format::Gray8>(RGB565{ (uint16_t)v }).v == rgb565_2gray((uint16_t)v), "rgb565_2gray %04X", v);
+        float fr, fg, fb;
+        rgb565_2f01((uint16_t)v, &fr, &fg, &fb);
+        RgbF f = rgb565_2f01(RGB565{ (uint16_t)v });
+        CHECK(f.r == fr && f.g == fg && f.b == fb, "rgb565_2f01 %04X", v);
+    }
+
+    for (uint32_t v = 0; v < 0x1000000; v++) {
+        uint8_t r = v >> 16, g = v >> 8, b = v;
+        RGB888 p{ r, g, b };
+        if (convert<Format::Gray8>(p).v != rgb888_2gray(r, g, b)) { CHECK(0, "rgb888_2gray %06X", v); break; }
+        if (convert<Format::RGB565>(p).v != rgb888_2rgb565(r, g, b)) { CHECK(0, "rgb888_2rgb565 %06X", v); break; }
+        if (ansi256(p) != ::rgb2ansi256(r, g, b)) { CHECK(0, "rgb2ansi256 %06X", v); break; }
+    }
+
+    for (int i = 0; i < 200000; i++) {
+        uint32_t a = rnd32(), b = rnd32();
+        uint8_t a8 = rand();
+        CHECK(blend(ARGB32{ a }, ARGB32{ b }).v == blend2argb32(a, b), "blend2argb32 %08X %08X", a, b);
+        CHECK(blend(RGBA32{ a }, RGBA32{ b }).v == blend2rgba32(a, b), "blend2rgba32 %08X %08X", a, b);
+        CHECK(blend(RGB565{ (uint16_t)a }, RGB565{ (uint16_t)b }, a8).v == blend2rgb565(a, b, a8), "blend2rgb565");
+        uint8_t r8, g8, b8;
+        blend2rgb888(a >> 16, a >> 8, a, b >> 16, b >> 8, b, a8, &r8, &g8, &b8);
+        RGB888 o = blend(RGB888{ (uint8_t)(a >> 16), (uint8_t)(a >> 8), (uint8_t)a },
+                         RGB888{ (uint8_t)(b >> 16), (uint8_t)(b >> 8), (uint8_t)b }, a8);
+        CHECK(o.r == r8 && o.g == g8 && o.b == b8, "blend2rgb888");
+
+        CHECK(premul(ARGB32{ a }).v == premulARGB32(a), "premulARGB32 %08X", a);
+        CHECK(premul(RGBA32{ a }).v == premulRGBA32(a), "premulRGBA32 %08X", a);
+        ARGB32_t pa = premulARGB32(a), pb = premulARGB32(b);
+        CHECK(unpremul(ARGB32{ pa }).v == unpremulARGB32(pa), "unpremulARGB32 %08X", pa);
+        for (int op = 0; op < PD_COUNT; op++) {
+            ARGB32_t d = pa;
+            compositeSpanARGB32((porterduff_op_t)op, &d, &pb, 1);
+            CHECK(composite((porterduff_op_t)op, ARGB32{ pa }, ARGB32{ pb }).v == d, "composite op %d", op);
+        }
+
+        float h = (rand() % 36000) / 100.0f, s = rand() / (float)RAND_MAX * 1.2f - 0.1f, v = rand() / (float)RAND_MAX;
+        float cr, cg, cb;
+        hsv2rgb(h, s, v, &cr, &cg, &cb);
+        RgbF x = colorutl::hsv2rgb(h, s, v);
+        CHECK(x.r == cr && x.g == cg && x.b == cb, "hsv2rgb %f %f %f", h, s, v);
+        hsl2rgb(h, s, v, &cr, &cg, &cb);
+        x = colorutl::hsl2rgb(h, s, v);
+        CHECK(x.r == cr && x.g == cg && x.b == cb, "hsl2rgb %f %f %f", h, s, v);
+        RGB888 q = colorutl::f01_2rgb888(cr, cg, s);
+        ::f01_2rgb888(cr, cg, s, &r8, &g8, &b8);
+        CHECK(q.r == r8 && q.g == g8 && q.b == b8, "f01_2rgb888");
+        CHECK(colorutl::f01_2rgb565(cr, cg, s).v == ::f01_2rgb565(cr, cg, s), "f01_2rgb565");
+    }
+
+    static const float HUES[] = { 360.0f, 450.0f, 719.99f, 720.0f, -0.0f, -30.0f, -360.0f, -450.5f, 1e7f, -3.3e9f, 1e30f,
+                                  __builtin_inff(), -__builtin_inff(), __builtin_nanf("") };
+    for (float h : HUES) check_hue(h, 0.8f, 0.6f);
+    for (int i = 0; i < 100000; i++)
+        check_hue((rand() % 400000 - 200000) / 100.0f, rand() / (float)RAND_MAX, rand() / (float)RAND_MAX);
+
+    const float gammas[] = { 0.45f, 1.0f, 1.8f, 2.2f, 2.4f, 2.8f };
+    for (float gm : gammas) {
+        Table<uint8_t, 256> t = gammaTable(gm);
+        for (int i = 0; i < 256; i++) CHECK(t[i] == applyGamma8((uint8_t)i, gm), "gamma %.2f [%d]: %d vs %d", gm, i, t[i], applyGamma8((uint8_t)i, gm));
+    }
+
+    return test_report("colorutl.hpp");
+}
@@ -0,0 +1,79 @@
+// Build with -DCOLORUTL_INLINE: plain calls use the header versions, while
+// the function pointers below still reach the library exports.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <colorUtils/colorutl.h>
+
+#ifndef COLORUTL_INLINE
+#error "compile with -DCOLORUTL_INLINE"
+#endif
+
+static uint16_t (*lib_rgb888_2rgb565)(uint8_t, uint8_t, uint8_t) = rgb888_2rgb565;
+static void (*lib_rgb565_2rgb888)(uint16_t, uint8_t *, uint8_t *, uint8_t *) = rgb565_2rgb888;
+static uint8_t (*lib_rgb888_2gray)(uint8_t, uint8_t, uint8_t) = rgb888_2gray;
+static uint8_t (*lib_rgb565_2gray)(uint16_t) = rgb565_2gray;
+static uint8_t (*lib_gray2_1bit)(uint8_t) = gray2_1bit;
+static uint8_t (*lib_rgb2ansi256)(uint8_t, uint8_t, uint8_t) = rgb2ansi256;
+static void (*lib_rgb565_2f01)(uint16_t, float *, float *, float *) = rgb565_2f01;
+static uint16_t (*lib_f01_2rgb565)(float, float, float) = f01_2rgb565;
+static void (*lib_f01_2rgb888)(float, float, float, uint8_t *, uint8_t *, uint8_t *) = f01_2rgb888;
+static uint16_t (*lib_blend2rgb565)(uint16_t, uint16_t, uint8_t) = blend2rgb565;
+static ARGB32_t (*lib_blend2argb32)(ARGB32_t, ARGB32_t) = blend2argb32;
+static RGBA32_t (*lib_blend2rgba32)(RGBA32_t, RGBA32_t) = blend2rgba32;
+
+int main(void) {
+    int fail = 0;
+
+    for (uint32_t v = 0; v < 0x1000000; v++) {
+        uint8_t r = v >> 16, g = v >> 8, b = v;
+        if (rgb888_2rgb565(r, g, b) != lib_rgb888_2rgb565(r, g, b) ||
+            rgb888_2gray(r, g, b) != lib_rgb888_2gray(r, g, b) ||
+            rgb2ansi256(r, g, b) != lib_rgb2ansi256(r, g, b)) {
+            printf("rgb888 %06X mismatch\n", v);
+            fail++;
+            break;
+        }
+    }
+
+    for (uint32_t v = 0; v < 0x10000; v++) {
+        uint8_t r0, g0, b0, r1, g1, b1;
+        float fr0, fg0, fb0, fr1, fg1, fb1;
+        rgb565_2rgb888((uint16_t)v, &r0, &g0, &b0);
+        lib_rgb565_2rgb888((uint16_t)v, &r1, &g1, &b1);
+        rgb565_2f01((uint16_t)v, &fr0, &fg0, &fb0);
+        lib_rgb565_2f01((uint16_t)v, &fr1, &fg1, &fb1);
+        if (r0 != r1 || g0 != g1 || b0 != b1 || fr0 != fr1 || fg0 != fg1 || fb0 != fb1 ||
+            rgb565_2gray((uint16_t)v) != lib_rgb565_2gray((uint16_t)v) ||
+            f01_2rgb565(fr0, fg0, fb0) != lib_f01_2rgb565(fr0, fg0, fb0)) {
+            printf("rgb565 %04X mismatch\n", v);
+            fail++;
+            break;
+        }
+    }
+
+    for (int v = 0; v < 256; v++) {
+        if (gray2_1bit((uint8_t)v) != lib_gray2_1bit((uint8_t)v)) { printf("gray2_1bit %d\n", v); fail++; }
+    }
+
+    srand(11);
+    for (int i = 0; i < 200000; i++) {
+        uint32_t a = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        uint32_t b = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        float f = rand() / (float)RAND_MAX * 1.2f - 0.1f;
+        uint8_t r0, g0, b0, r1, g1, b1;
+        f01_2rgb888(f, 1.0f - f, f * 0.5f, &r0, &g0, &b0);
+        lib_f01_2rgb888(f, 1.0f - f, f * 0.5f, &r1, &g1, &b1);
+        if (r0 != r1 || g0 != g1 || b0 != b1 ||
+            blend2rgb565((uint16_t)a, (uint16_t)b, (uint8_t)(a >> 24)) != lib_blend2rgb565((uint16_t)a, (uint16_t)b, (uint8_t)(a >> 24)) ||
+            blend2argb32(a, b) != lib_blend2argb32(a, b) ||
+            blend2rgba32(a, b) != lib_blend2rgba32(a, b)) {
+            printf("sample %d mismatch (%08X %08X %f)\n", i, a, b, f);
+            fail++;
+            break;
+        }
+    }
+
+    printf("colorutl_inline: %s (%d failures)\n", fail ? "FAIL" : "OK", fail);
+    return fail ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+#define N 1027
+
+static const char *OPS[PD_COUNT] = {
+    "CLEAR", "SRC", "DST", "SRC_OVER", "DST_OVER", "SRC_IN", "DST_IN",
+    "SRC_OUT", "DST_OUT", "SRC_ATOP", "DST_ATOP", "XOR", "PLUS"
+};
+
+static ARGB32_t src[N], dst[N], out[N];
+
+static ARGB32_t rand_premul(void) {
+    uint32_t a = rand() & 0xFF;
+    if ((rand() & 7) == 0) a = 0xFF;
+    if ((rand() & 7) == 0) a = 0;
+    uint32_t r = (rand() & 0xFF) * a / 255, g = (rand() & 0xFF) * a / 255, b = (rand() & 0xFF) * a / 255;
+    return ARGB32_GET(a, r, g, b);
+}
+
+// Floating-point Porter-Duff on premultiplied channels.
+static ARGB32_t ref(porterduff_op_t op, ARGB32_t d, ARGB32_t s) {
+    double sa = ARGB32_GET_A(s) / 255.0, da = ARGB32_GET_A(d) / 255.0, fa = 0, fb = 0;
+    switch (op) {
+    case PD_CLEAR:    fa = 0;      fb = 0;      break;
+    case PD_SRC:      fa = 1;      fb = 0;      break;
+    case PD_DST:      fa = 0;      fb = 1;      break;
+    case PD_SRC_OVER: fa = 1;      fb = 1 - sa; break;
+    case PD_DST_OVER: fa = 1 - da; fb = 1;      break;
+    case PD_SRC_IN:   fa = da;     fb = 0;      break;
+    case PD_DST_IN:   fa = 0;      fb = sa;     break;
+    case PD_SRC_OUT:  fa = 1 - da; fb = 0;      break;
+    case PD_DST_OUT:  fa = 0;      fb = 1 - sa; break;
+    case PD_SRC_ATOP: fa = da;     fb = 1 - sa; break;
+    case PD_DST_ATOP: fa = 1 - da; fb = sa;     break;
+    case PD_XOR:      fa = 1 - da; fb = 1 - sa; break;
+    case PD_PLUS:     fa = 1;      fb = 1;      break;
+    default: break;
+    }
+    uint32_t o = 0;
+    for (int sh = 0; sh < 32; sh += 8) {
+        double c = ((s >> sh) & 0xFF) * fa + ((d >> sh) & 0xFF) * fb;
+        o |= (uint32_t)fmin(255.0, floor(c + 0.5)) << sh;
+    }
+    return o;
+}
+
+static int close1(uint32_t a, uint32_t b) {
+    for (int sh = 0; sh < 32; sh += 8) {
+        int d = (int)((a >> sh) & 0xFF) - (int)((b >> sh) & 0xFF);
+        if (d < -1 || d > 1) return 0;
+    }
+    return 1;
+}
+
+// Straight (not premultiplied) pixels through every op: spans of lengths that
+// end inside and just past the 4- and 8-pixel vector bodies must match the
+// per-pixel scalar path byte for byte.
+static void check_unpremultiplied(void) {
+    static const size_t LENS[] = { 1, 15, 16, 17, 33 };
+    ARGB32_t s[33], d[33], span[33];
+    for (int op = 0; op < PD_COUNT; op++) {
+        for (size_t l = 0; l < sizeof(LENS) / sizeof(LENS[0]); l++) {
+            size_t n = LENS[l];
+            for (size_t i = 0; i < n; i++) {
+                s[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+                d[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+                if (i % 3 == 0) s[i] |= 0x00FFFFFFu;   // channels far above alpha
+                span[i] = d[i];
+            }
+            compositeSpanARGB32(op, span, s, n);
+            for (size_t i = 0; i < n; i++) {
+                ARGB32_t one = d[i];
+                compositeSpanARGB32(op, &one, &s[i], 1);
+                CHECK(span[i] == one, "%s unpremultiplied n=%zu [%zu]: span %08X scalar %08X", OPS[op], n, i, span[i], one);
+            }
+        }
+    }
+    ARGB32_t over[33], red[33];
+    for (int i = 0; i < 33; i++) {
+        over[i] = 0x80FF8040u;
+        red[i] = 0x20FF0000u;
+    }
+    compositeSpanARGB32(PD_SRC_OVER, over, red, 33);
+    for (int i = 0; i < 33; i++) CHECK(over[i] == 0x90FF7038u, "SRC_OVER 20FF0000 over 80FF8040 [%d]: %08X", i, over[i]);
+}
+
+int main(void) {
+    int rc = test_each_cpu_level();
+    if (rc >= 0) return rc;
+    srand(3);
+    for (int i = 0; i < N; i++) { src[i] = rand_premul(); dst[i] = rand_premul(); }
+
+    for (int op = 0; op < PD_COUNT; op++) {
+        for (int i = 0; i < N; i++) out[i] = dst[i];
+        compositeSpanARGB32(op, out, src, N);
+        for (int i = 0; i < N; i++) {
+            ARGB32_t one = dst[i];
+            compositeSpanARGB32(op, &one, &src[i], 1);   // scalar tail path
+            if (one != out[i] || !close1(out[i], ref(op, dst[i], src[i]))) {
+                printf("%s[%d]: span %08X single %08X ref %08X\n", OPS[op], i, out[i], one, ref(op, dst[i], src[i]));
+                fail++;
+                break;
+            }
+        }
+        // RGBA32 is the same math with the alpha byte moved.
+        RGBA32_t rs[N], rd[N];
+        for (int i = 0; i < N; i++) { rs[i] = (src[i] << 8) | (src[i] >> 24); rd[i] = (dst[i] << 8) | (dst[i] >> 24); }
+        compositeSpanRGBA32(op, rd, rs, N);
+        for (int i = 0; i < N; i++) {
+            if (((rd[i] >> 8) | (rd[i] << 24)) != out[i]) { printf("%s RGBA32[%d] mismatch\n", OPS[op], i); fail++; break; }
+        }
+    }
+
+    // Premultiply round trip and agreement with blend2argb32 over an opaque background.
+    for (int i = 0; i < N; i++) {
+        ARGB32_t straight = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        ARGB32_t p, single = premulARGB32(straight);
+        premulSpanARGB32(&p, &straight, 1);
+        ARGB32_t back = unpremulARGB32(p);
+        uint32_t a = ARGB32_GET_A(straight);
+        if (p != single || (a == 255 && back != straight) || (a != 0 && ARGB32_GET_A(back) != a)) {
+            printf("premul[%d]: %08X -> %08X -> %08X\n", i, straight, p, back);
+            fail++;
+        }
+        ARGB32_t bg = straight | 0xFF000000u, over = bg;
+        ARGB32_t fg = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        ARGB32_t pfg = premulARGB32(fg);
+        compositeSpanARGB32(PD_SRC_OVER, &over, &pfg, 1);
+        if (!close1(over, blend2argb32(bg, fg))) {
+            printf("src_over[%d]: %08X vs blend2argb32 %08X\n", i, over, blend2argb32(bg, fg));
+            fail++;
+        }
+    }
+    ARGB32_t big[N], bigp[N];
+    for (int i = 0; i < N; i++) big[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+    premulSpanARGB32(bigp, big, N);
+    for (int i = 0; i < N; i++) if (bigp[i] != premulARGB32(big[i])) { printf("premulSpan[%d] mismatch\n", i); fail++; break; }
+
+    check_unpremultiplied();
+
+    char name[32];
+    snprintf(name, sizeof(name), "composite [%s]", cpuLevelName(cpuLevel()));
+    return test_report(name);
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <crcUtils/crcutl.h>
+#include <printHexTable/printHexTable.h>
+#include "testutil.h"
+
+// Bit-at-a-time reference straight from the parameter model.
+static uint32_t reflect(uint32_t v, int width) {
+    uint32_t r = 0;
+    for (int i = 0; i < width; i++, v >>= 1) r = (r << 1) | (v & 1);
+    return r;
+}
+
+static uint32_t crc_bitwise(int width, uint32_t poly, uint32_t init, int refin, int refout, uint32_t xorout,
+                            const uint8_t *p, size_t len) {
+    uint32_t top = 1u << (width - 1);
+    uint32_t mask = (width == 32) ? 0xFFFFFFFFu : (1u << width) - 1;
+    uint32_t reg = init & mask;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t b = refin ? reflect(p[i], 8) : p[i];
+        for (int k = 7; k >= 0; k--) {
+            uint32_t bit = ((b >> k) & 1) ^ ((reg & top) ? 1 : 0);
+            reg = (reg << 1) & mask;
+            if (bit) reg ^= poly & mask;
+        }
+    }
+    if (refout) reg = reflect(reg, width);
+    return (reg ^ xorout) & mask;
+}
+
+int main(void) {
+    static const uint32_t CHECK_VALUES[CRC_PRESET_COUNT] = {
+        [CRC16_CCITT_FALSE] = 0x29B1, [CRC16_XMODEM] = 0x31C3, [CRC16_KERMIT] = 0x2189,
+        [CRC16_X25] = 0x906E,         [CRC16_MODBUS] = 0x4B37, [CRC32] = 0xCBF43926,
+        [CRC32C] = 0xE3069283,        [CRC32_MPEG2] = 0x0376E6E7,
+    };
+    static crc_t crc;
+    for (int p = 0; p < CRC_PRESET_COUNT; p++) {
+        CHECK(crcInitPreset(&crc, (crc_preset_t)p) == 0, "preset %d init", p);
+        uint32_t v = crcCompute(&crc, "123456789", 9);
+        CHECK(v == CHECK_VALUES[p], "preset %d check value %08X, want %08X", p, v, CHECK_VALUES[p]);
+    }
+    CHECK(crcInitPreset(&crc, CRC_PRESET_COUNT) == -1 && crcInit(&crc, 7, 1, 0, 0, 0, 0) == -1, "bad parameters accepted");
+
+    // Random models and lengths against the bitwise reference, whole and in pieces.
+    static uint8_t data[1024];
+    srand(11);
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)rand();
+    for (int t = 0; t < 300; t++) {
+        int width = 8 + rand() % 25;
+        uint32_t poly = ((uint32_t)rand() << 16 ^ (uint32_t)rand()) | 1;
+        uint32_t init = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+        uint32_t xorout = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+        int refin = rand() & 1, refout = rand() & 1;
+        size_t len = (size_t)rand() % sizeof(data);
+        crcInit(&crc, (uint8_t)width, poly, init, refin, refout, xorout);
+        uint32_t want = crc_bitwise(width, poly, init, refin, refout, xorout, data, len);
+        CHECK(crcCompute(&crc, data, len) == want, "width %d refin %d refout %d len %zu", width, refin, refout, len);
+
+        size_t cut = len ? (size_t)rand() % len : 0;
+        uint32_t reg = crcBegin(&crc);
+        reg = crcUpdate(&crc, reg, data, cut);
+        reg = crcUpdate(&crc, reg, data + cut, len - cut);
+        CHECK(crcFinal(&crc, reg) == want, "incremental width %d cut %zu/%zu", width, cut, len);
+    }
+
+    // Overlay: a 64-byte frame, CRC-16/CCITT over bytes 4..61, big-endian trailer at 62.
+    uint8_t frame[64];
+    memcpy(frame, data, sizeof(frame));
+    crcInitPreset(&crc, CRC16_CCITT_FALSE);
+    uint32_t fcs = crcCompute(&crc, frame + 4, 58);
+    frame[62] = (uint8_t)(fcs >> 8);
+    frame[63] = (uint8_t)fcs;
+    ANSIErrTagMap256_t tag = { 0 };
+    CHECK(hexCrcTag256(&crc, frame, sizeof(frame), 4, 58, 62, true, &tag) == 1, "good CRC rejected");
+    CHECK(tag.errLevel[4] == ANSI_ErrLevel_NML && tag.errLevel[63] == ANSI_ErrLevel_NML, "good CRC tagged");
+
+    // Split into header / payload / trailer, read in place.
+    HexSeg_t segs[] = { { frame, 10 }, { frame + 10, 52 }, { frame + 62, 2 } };
+    CHECK(hexCrcTag256v(&crc, segs, 3, 4, 58, 62, true, &tag) == 1, "segmented good CRC rejected");
+
+    frame[30] ^= 0x40;
+    CHECK(hexCrcTag256v(&crc, segs, 3, 4, 58, 62, true, &tag) == 0, "bad CRC accepted");
+    CHECK(tag.errLevel[3] == ANSI_ErrLevel_NML && tag.errLevel[4] == ANSI_ErrLevel_WAN &&
+          tag.errLevel[61] == ANSI_ErrLevel_WAN && tag.errLevel[62] == ANSI_ErrLevel_ERR &&
+          tag.errLevel[63] == ANSI_ErrLevel_ERR, "bad CRC not tagged");
+    CHECK(hexCrcTag256(&crc, frame, sizeof(frame), 4, 58, 63, true, &tag) == -1, "trailer past the end accepted");
+
+    // Little-endian CRC-32 trailer.
+    uint8_t pkt[20];
+    memcpy(pkt, data + 100, 16);
+    crcInitPreset(&crc, CRC32);
+    uint32_t c32 = crcCompute(&crc, pkt, 16);
+    for (int i = 0; i < 4; i++) pkt[16 + i] = (uint8_t)(c32 >> (8 * i));
+    CHECK(hexCrcTag256(&crc, pkt, sizeof(pkt), 0, 16, 16, false, NULL) == 1, "CRC-32 trailer rejected");
+
+    // Throughput.
+    size_t big_len = 64u << 20;
+    uint8_t *big = malloc(big_len);
+    for (size_t i = 0; i < big_len; i++) big[i] = (uint8_t)(i * 2654435761u >> 24);
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    volatile uint32_t sink = crcCompute(&crc, big, big_len);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    (void)sink;
+    double sec = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    printf("crcutl: CRC-32 over %zu MB in %.1f ms (%.0f MB/s)\n", big_len >> 20, sec * 1e3, (double)(big_len >> 20) / sec);
+    free(big);
+
+    return test_report("crcutl");
+}
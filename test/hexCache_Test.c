@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <printfUtils/printfutl.h>
+#include <printHexTable/printHexTable.h>
+#include "testutil.h"
+
+#define THREADS 4
+#define FRAMES 8
+
+static uint8_t frames[FRAMES][64];
+static char *reference[FRAMES];
+static ANSIColorMap256_t clr;
+static ANSIErrTagMap256_t tag;
+static HexCache_t *shared;
+
+static void *reader(void *arg) {
+    (void)arg;
+    for (int i = 0; i < 2000; i++) {
+        int f = i % FRAMES;
+        char *s = hexCacheColorTable256(shared, frames[f], sizeof(frames[f]), &clr, &tag, "beacon", NULL);
+        if (!s || strcmp(s, reference[f]) != 0) {
+            printf("thread output differs for frame %d\n", f);
+            __atomic_add_fetch(&fail, 1, __ATOMIC_RELAXED);
+            utlFree(s);
+            break;
+        }
+        utlFree(s);
+    }
+    return NULL;
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec * 1e-3;
+}
+
+int main(void) {
+    for (int f = 0; f < FRAMES; f++)
+        for (int i = 0; i < 64; i++) frames[f][i] = (uint8_t)(f * 31 + i * 7);
+    addr2AnsiColorMap256(&clr, 4, 9, "\e[1;33m", 4, '[', 9, ']', 1);
+    addr2AnsiErrTag256(&tag, 20, 23, ANSI_ErrLevel_ERR);
+    for (int f = 0; f < FRAMES; f++)
+        reference[f] = printColorHexTable256(frames[f], sizeof(frames[f]), &clr, &tag, "beacon", NULL);
+
+    HexCache_t *cache = hexCacheNew(1 << 20);
+    HexCacheStats_t st;
+    char *a = hexCacheColorTable256(cache, frames[0], 64, &clr, &tag, "beacon", NULL);
+    char *b = hexCacheColorTable256(cache, frames[0], 64, &clr, &tag, "beacon", NULL);
+    CHECK(a && b && a != b && strcmp(a, reference[0]) == 0 && strcmp(b, reference[0]) == 0, "cached output differs");
+    hexCacheStats(cache, &st);
+    CHECK(st.hits == 1 && st.misses == 1 && st.entries == 1, "hits %llu misses %llu",
+          (unsigned long long)st.hits, (unsigned long long)st.misses);
+    utlFree(a);
+    utlFree(b);
+
+    // Anything the renderer reads is part of the key.
+    char yellow[] = "\e[1;33m";
+    ANSIColorMap256_t clr2 = clr;
+    for (int i = 4; i <= 9; i++) clr2.ansiColorStr[i] = yellow;   // same colour, other pointer
+    a = hexCacheColorTable256(cache, frames[0], 64, &clr2, &tag, "beacon", NULL);
+    hexCacheStats(cache, &st);
+    CHECK(st.hits == 2, "equal colour strings at another address missed");
+    utlFree(a);
+    yellow[5] = '2';
+    a = hexCacheColorTable256(cache, frames[0], 64, &clr2, &tag, "beacon", NULL);
+    hexCacheStats(cache, &st);
+    CHECK(st.misses == 2 && a && strstr(a, "\e[1;32m"), "changed colour string served stale output");
+    utlFree(a);
+    frames[1][63] ^= 1;
+    utlFree(reference[1]);
+    reference[1] = printColorHexTable256(frames[1], 64, &clr, &tag, "beacon", NULL);
+    utlFree(hexCacheColorTable256(cache, frames[1], 64, &clr, &tag, "beacon", NULL));
+    utlFree(hexCacheColorTable256(cache, frames[1], 63, &clr, &tag, "beacon", NULL));
+    utlFree(hexCacheColorTable256(cache, frames[1], 64, &clr, NULL, "beacon", NULL));
+    utlFree(hexCacheColorTable256(cache, frames[1], 64, &clr, &tag, "ack", NULL));
+    a = hexCacheTable256(cache, frames[1], 64, "beacon", NULL);
+    hexCacheStats(cache, &st);
+    CHECK(st.misses == 7 && st.hits == 2, "key collision: misses %llu", (unsigned long long)st.misses);
+    char *plain = printHexTable256(frames[1], 64, "beacon", NULL);
+    CHECK(a && strcmp(a, plain) == 0, "plain table differs");
+    utlFree(a);
+    utlFree(plain);
+
+    // Emitting to a stream.
+    char *mem = NULL;
+    size_t memlen = 0;
+    FILE *fp = open_memstream(&mem, &memlen);
+    long n1 = hexCacheFputColorTable256(cache, fp, frames[0], 64, &clr, &tag, "beacon", NULL);
+    long n2 = hexCacheFputColorTable256(cache, fp, frames[0], 64, &clr, &tag, "beacon", NULL);
+    fclose(fp);
+    size_t rlen = strlen(reference[0]);
+    CHECK(n1 == (long)rlen && n2 == (long)rlen && memlen == 2 * rlen && memcmp(mem, reference[0], rlen) == 0 &&
+          memcmp(mem + rlen, reference[0], rlen) == 0, "hexCacheFputColorTable256");
+    free(mem);
+    hexCacheFree(cache);
+
+    // A budget of about three tables keeps the three most recently used.
+    cache = hexCacheNew(1 << 20);
+    utlFree(hexCacheColorTable256(cache, frames[0], 64, &clr, &tag, "beacon", NULL));
+    hexCacheStats(cache, &st);
+    size_t cost = st.bytes;   // table, key and bookkeeping
+    hexCacheFree(cache);
+    cache = hexCacheNew(3 * cost + cost / 2);
+    for (int f = 0; f < 4; f++) utlFree(hexCacheColorTable256(cache, frames[f], 64, &clr, &tag, "beacon", NULL));
+    hexCacheStats(cache, &st);
+    CHECK(st.entries == 3 && st.evictions == 1 && st.bytes <= st.maxBytes, "entries %zu evictions %llu",
+          st.entries, (unsigned long long)st.evictions);
+    utlFree(hexCacheColorTable256(cache, frames[3], 64, &clr, &tag, "beacon", NULL));
+    utlFree(hexCacheColorTable256(cache, frames[0], 64, &clr, &tag, "beacon", NULL));
+    hexCacheStats(cache, &st);
+    CHECK(st.hits == 1 && st.misses == 5, "LRU order: hits %llu misses %llu",
+          (unsigned long long)st.hits, (unsigned long long)st.misses);
+    hexCacheClear(cache);
+    hexCacheStats(cache, &st);
+    CHECK(st.entries == 0 && st.bytes == 0, "hexCacheClear");
+    hexCacheFree(cache);
+
+    // Concurrent readers.
+    shared = hexCacheNew(1 << 20);
+    pthread_t th[THREADS];
+    for (int i = 0; i < THREADS; i++) pthread_create(&th[i], NULL, reader, NULL);
+    for (int i = 0; i < THREADS; i++) pthread_join(th[i], NULL);
+    hexCacheStats(shared, &st);
+    CHECK(st.hits + st.misses == THREADS * 2000 && st.entries == FRAMES, "threads: hits %llu misses %llu",
+          (unsigned long long)st.hits, (unsigned long long)st.misses);
+
+    double t0 = now_us();
+    for (int i = 0; i < 1000; i++) utlFree(printColorHexTable256(frames[i % FRAMES], 64, &clr, &tag, "beacon", NULL));
+    double t1 = now_us();
+    for (int i = 0; i < 1000; i++) utlFree(hexCacheColorTable256(shared, frames[i % FRAMES], 64, &clr, &tag, "beacon", NULL));
+    double t2 = now_us();
+    printf("hexCache: render %.1f us, cached %.1f us per table\n", (t1 - t0) / 1000, (t2 - t1) / 1000);
+    hexCacheFree(shared);
+
+    // Readers racing a cache that only fits two tables: hits keep their entry
+    // alive while it is evicted under them.
+    shared = hexCacheNew(2 * cost + cost / 2);
+    for (int i = 0; i < THREADS; i++) pthread_create(&th[i], NULL, reader, NULL);
+    for (int i = 0; i < THREADS; i++) pthread_join(th[i], NULL);
+    hexCacheStats(shared, &st);
+    CHECK(st.entries <= 2 && st.evictions > 0 && st.bytes <= st.maxBytes, "small shared cache: entries %zu", st.entries);
+    hexCacheFree(shared);
+
+    for (int f = 0; f < FRAMES; f++) utlFree(reference[f]);
+    return test_report("hexCache");
+}
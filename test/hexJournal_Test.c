@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <printfUtils/printfutl.h>
+#include <printHexTable/printHexTable.h>
+#include "testutil.h"
+
+#define FRAMES 1000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void frame_bytes(int i, uint8_t *buf, size_t len) {
+    for (size_t k = 0; k < len; k++) buf[k] = (uint8_t)(i * 13 + k * 7);
+}
+
+static size_t frame_len(int i) {
+    return 16 + (size_t)(i * 37) % 300;   // some longer than the 256-byte maps
+}
+
+int main(void) {
+    char path[] = "/tmp/hexJournal_TestXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    close(fd);
+    unlink(path);
+
+    ANSIColorMap256_t clr = { 0 };
+    ANSIErrTagMap256_t tag = { 0 };
+    addr2AnsiColorMap256(&clr, 4, 9, "\e[1;33m", 4, '[', 9, ']', 1);
+    addr2AnsiColorMap256(&clr, 12, 13, "\e[1;36m", 12, '<', 13, '>', 1);
+    addr2AnsiErrTag256(&tag, 20, 23, ANSI_ErrLevel_ERR);
+    HexJournalRange_t ranges[] = {
+        { 0, 3, "\e[1;32m", '(', ')', ANSI_ErrLevel_NML },
+        { 6, 7, NULL, 0, 0, ANSI_ErrLevel_WAN },
+    };
+
+    // Small buffer, so records straddle flushes and big frames go around it.
+    HexJournal_t *j = hexJournalOpen(path, 1024);
+    CHECK(j != NULL, "hexJournalOpen");
+    static uint8_t buf[512];
+    for (int i = 0; i < FRAMES; i++) {
+        size_t len = frame_len(i);
+        frame_bytes(i, buf, len);
+        int rc = (i % 2) ? hexJournalAppendMaps(j, 1000u * (uint64_t)i, buf, len, &clr, &tag, "beacon")
+                         : hexJournalAppend(j, 1000u * (uint64_t)i, buf, len, ranges, 2, (i % 4) ? "ack" : NULL);
+        CHECK(rc == 0, "append %d", i);
+    }
+    HexJournalRange_t bad = { 5, 4, NULL, 0, 0, ANSI_ErrLevel_NML };
+    CHECK(hexJournalAppend(j, 0, buf, 16, &bad, 1, NULL) == -1, "reversed range accepted");
+    CHECK(hexJournalClose(j) == 0, "hexJournalClose");
+
+    // Reopen for append: strings carry over, so the new entries reuse their ids.
+    j = hexJournalOpen(path, 0);
+    frame_bytes(FRAMES, buf, 64);
+    CHECK(j && hexJournalAppendMaps(j, 42, buf, 64, &clr, &tag, "beacon") == 0, "append after reopen");
+    hexJournalClose(j);
+
+    HexJournalReader_t *r = hexJournalReaderOpen(path);
+    CHECK(r && hexJournalCount(r) == FRAMES + 1, "count %zu", hexJournalCount(r));
+
+    // Rendering from the journal matches rendering on the spot, in any order.
+    for (int n = 0; n < FRAMES + 1; n++) {
+        int i = (n * 389) % (FRAMES + 1);
+        size_t len = i == FRAMES ? 64 : frame_len(i);
+        frame_bytes(i, buf, len);
+        const HexJournalEntry_t *e = hexJournalGet(r, (size_t)i);
+        CHECK(e && e->len == len && memcmp(e->data, buf, len) == 0 &&
+              e->timestamp == (i == FRAMES ? 42u : 1000u * (uint64_t)i), "entry %d", i);
+
+        char *want, *got = hexJournalRender(r, (size_t)i, true, "tail");
+        if (i % 2 || i == FRAMES) {
+            want = printColorHexTable256(buf, len, &clr, &tag, "beacon", "tail");
+        } else {
+            ANSIColorMap256_t c = { 0 };
+            ANSIErrTagMap256_t t = { 0 };
+            addr2AnsiColorMap256(&c, 0, 3, "\e[1;32m", 0, '(', 3, ')', 1);
+            addr2AnsiErrTag256(&t, 6, 7, ANSI_ErrLevel_WAN);
+            want = printColorHexTable256(buf, len, &c, &t, (i % 4) ? "ack" : NULL, "tail");
+        }
+        CHECK(got && want && strcmp(got, want) == 0, "render %d differs", i);
+        utlFree(got);
+        utlFree(want);
+    }
+    char *plain = hexJournalRender(r, 1, false, NULL);
+    frame_bytes(1, buf, frame_len(1));
+    char *want = printHexTable256(buf, frame_len(1), "beacon", NULL);
+    CHECK(plain && strcmp(plain, want) == 0, "plain render differs");
+    utlFree(plain);
+    utlFree(want);
+    CHECK(hexJournalGet(r, FRAMES + 1) == NULL && hexJournalRender(r, FRAMES + 1, true, NULL) == NULL, "index past end");
+    hexJournalReaderClose(r);
+
+    // A torn last record is skipped by the reader and cut off by the next writer.
+    FILE *fp = fopen(path, "ab");
+    fwrite("\x40\x00\x00\x00\x01\x00", 1, 6, fp);
+    fclose(fp);
+    r = hexJournalReaderOpen(path);
+    CHECK(r && hexJournalCount(r) == FRAMES + 1, "torn record counted");
+    hexJournalReaderClose(r);
+    j = hexJournalOpen(path, 0);
+    CHECK(j && hexJournalAppend(j, 7, buf, 8, NULL, 0, NULL) == 0, "append after torn record");
+    hexJournalClose(j);
+    r = hexJournalReaderOpen(path);
+    const HexJournalEntry_t *e = r ? hexJournalGet(r, FRAMES + 1) : NULL;
+    CHECK(r && hexJournalCount(r) == FRAMES + 2 && e && e->timestamp == 7 && e->len == 8 && !e->title,
+          "entry after torn record");
+    hexJournalReaderClose(r);
+
+    // Corruption before the end is not a torn tail: both sides refuse the
+    // file and the writer leaves it alone rather than cutting good entries.
+    // That holds for a bad type and for a size prefix pointing past EOF.
+    static const struct { long off; int val; } CORRUPT[] = { { 8 + 4, 7 }, { 8 + 3, 0x7F }, { 8 + 1, 0x10 } };
+    fp = fopen(path, "rb");
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    for (size_t k = 0; k < sizeof(CORRUPT) / sizeof(CORRUPT[0]); k++) {
+        fp = fopen(path, "r+b");
+        fseek(fp, CORRUPT[k].off, SEEK_SET);
+        int old = fgetc(fp);
+        fseek(fp, CORRUPT[k].off, SEEK_SET);
+        fputc(CORRUPT[k].val, fp);
+        fclose(fp);
+        CHECK(hexJournalReaderOpen(path) == NULL, "reader accepted corrupt byte %ld", CORRUPT[k].off);
+        CHECK(hexJournalOpen(path, 0) == NULL, "writer accepted corrupt byte %ld", CORRUPT[k].off);
+        fp = fopen(path, "r+b");
+        fseek(fp, 0, SEEK_END);
+        CHECK(ftell(fp) == size, "journal with corrupt byte %ld was truncated", CORRUPT[k].off);
+        fseek(fp, CORRUPT[k].off, SEEK_SET);
+        fputc(old, fp);
+        fclose(fp);
+        r = hexJournalReaderOpen(path);
+        CHECK(r && hexJournalCount(r) == FRAMES + 2, "repaired journal");
+        hexJournalReaderClose(r);
+    }
+
+    // Thousands of distinct titles and colours, each interned once, survive a
+    // reopen with their ids intact.
+    unlink(path);
+    j = hexJournalOpen(path, 0);
+    char title[32], color[32];
+    for (int i = 0; i < 3000; i++) {
+        snprintf(title, sizeof(title), "node %d", i);
+        snprintf(color, sizeof(color), "\e[38;5;%dm", i % 700);
+        HexJournalRange_t rg = { 0, 1, color, 0, 0, ANSI_ErrLevel_NML };
+        CHECK(hexJournalAppend(j, (uint64_t)i, buf, 8, &rg, 1, title) == 0, "append title %d", i);
+        if (i == 1500) {
+            hexJournalClose(j);
+            j = hexJournalOpen(path, 0);
+        }
+    }
+    hexJournalClose(j);
+    r = hexJournalReaderOpen(path);
+    CHECK(r && hexJournalCount(r) == 3000, "distinct titles count");
+    for (int i = 0; r && i < 3000; i += 7) {
+        e = hexJournalGet(r, (size_t)i);
+        snprintf(title, sizeof(title), "node %d", i);
+        snprintf(color, sizeof(color), "\e[38;5;%dm", i % 700);
+        CHECK(e && e->title && strcmp(e->title, title) == 0 && e->nranges == 1 && strcmp(e->ranges[0].colorStr, color) == 0,
+              "distinct title %d", i);
+    }
+    hexJournalReaderClose(r);
+    struct stat st;
+    CHECK(stat(path, &st) == 0 && st.st_size < 3000 * 64 + 700 * 24, "strings written more than once (%ld bytes)",
+          (long)st.st_size);
+
+    fp = fopen(path, "wb");
+    fputs("not a journal", fp);
+    fclose(fp);
+    CHECK(hexJournalReaderOpen(path) == NULL && hexJournalOpen(path, 0) == NULL, "foreign file accepted");
+    unlink(path);
+
+    // Hot-path cost: journaling a 64-byte annotated frame against rendering it.
+    j = hexJournalOpen(path, 0);
+    frame_bytes(0, buf, 64);
+    const int N = 200000;
+    double t0 = now_ns();
+    for (int i = 0; i < N; i++) hexJournalAppend(j, (uint64_t)i, buf, 64, ranges, 2, "beacon");
+    double t1 = now_ns();
+    hexJournalClose(j);
+    for (int i = 0; i < 2000; i++) utlFree(printColorHexTable256(buf, 64, &clr, &tag, "beacon", NULL));
+    double t2 = now_ns();
+    printf("hexJournal: append %.0f ns per 64-byte frame, render %.0f ns\n", (t1 - t0) / N, (t2 - t1) / 2000);
+    unlink(path);
+
+    return test_report("hexJournal");
+}
@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <printHexTable/printHexTable.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+#define MAX_HITS 200000
+
+typedef struct {
+    uint64_t key[MAX_HITS];    // pos << 8 | pattern
+    size_t n;
+} hits_t;
+
+static hits_t got, want;
+
+static int collect(size_t pos, size_t pattern, void *user) {
+    hits_t *h = (hits_t *)user;
+    if (h->n < MAX_HITS) h->key[h->n++] = ((uint64_t)pos << 8) | pattern;
+    return 0;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void brute(const HexPattern_t *pat, size_t npat, const uint8_t *buf, size_t len, hits_t *h) {
+    h->n = 0;
+    for (size_t p = 0; p < len; p++) {
+        for (size_t k = 0; k < npat; k++) {
+            if (pat[k].len > len - p) continue;
+            size_t i = 0;
+            for (; i < pat[k].len; i++) {
+                uint8_t m = pat[k].mask ? pat[k].mask[i] : 0xFF;
+                if ((buf[p + i] ^ pat[k].bytes[i]) & m) break;
+            }
+            if (i == pat[k].len) collect(p, k, h);
+        }
+    }
+}
+
+static void compare(const HexPattern_t *pat, size_t npat, const uint8_t *buf, size_t len, const char *what) {
+    HexSearch_t s;
+    CHECK(hexSearchInit(&s, pat, npat) == 0, "%s: init failed", what);
+    got.n = 0;
+    size_t n = hexSearchScan(&s, buf, len, collect, &got);
+    brute(pat, npat, buf, len, &want);
+    qsort(got.key, got.n, sizeof(uint64_t), cmp_u64);
+    CHECK(n == got.n && got.n == want.n && memcmp(got.key, want.key, got.n * sizeof(uint64_t)) == 0,
+          "%s: %zu hits, brute force %zu", what, got.n, want.n);
+}
+
+static const uint8_t SYNC[] = { 0x2D, 0xD4 };
+static const uint8_t PREAMBLE[] = { 0xAA, 0xAA, 0xAA, 0xAA };
+static const uint8_t NODE[] = { 0x7E, 0x00, 0x42, 0x00 };
+static const uint8_t NODE_MASK[] = { 0xFF, 0x00, 0xFF, 0xF0 };   // any hop byte, low nibble is a flag
+static const uint8_t MAGIC[] = { 'R', 'U', 0x01 };
+
+int main(void) {
+    static uint8_t buf[1 << 16];
+    srand(7);
+    for (size_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)(rand() & 0x7F);
+    for (size_t i = 0; i < sizeof(buf); i += 997) memcpy(buf + i, PREAMBLE, 4);
+    memcpy(buf, SYNC, 2);                                  // hit at offset 0
+    memcpy(buf + sizeof(buf) - 4, NODE, 4);                // hit ending at the last byte
+    buf[sizeof(buf) - 1] = 0x07;
+
+    HexPattern_t one[] = { { SYNC, NULL, 2, "\e[1;32m", '<', '>', ANSI_ErrLevel_NML } };
+    compare(one, 1, buf, sizeof(buf), "single anchor (memchr)");
+
+    HexPattern_t set[] = {
+        { SYNC, NULL, 2, NULL, 0, 0, ANSI_ErrLevel_NML },
+        { PREAMBLE, NULL, 4, NULL, 0, 0, ANSI_ErrLevel_NML },
+        { NODE, NODE_MASK, 4, NULL, 0, 0, ANSI_ErrLevel_NML },
+        { MAGIC, NULL, 3, NULL, 0, 0, ANSI_ErrLevel_NML },
+    };
+    compare(set, 4, buf, sizeof(buf), "masked set (vector)");
+    for (size_t len = 0; len < 70; len++) compare(set, 4, buf + sizeof(buf) - len, len, "short tail");
+
+    // More distinct anchors than the vector loop takes: table scan.
+    static uint8_t many_bytes[12][2];
+    HexPattern_t many[12];
+    for (int k = 0; k < 12; k++) {
+        many_bytes[k][0] = (uint8_t)(0x90 + k);
+        many_bytes[k][1] = (uint8_t)k;
+        many[k] = (HexPattern_t){ many_bytes[k], NULL, 2, NULL, 0, 0, ANSI_ErrLevel_NML };
+        buf[100 + k * 50] = (uint8_t)(0x90 + k);
+        buf[101 + k * 50] = (uint8_t)k;
+    }
+    compare(many, 12, buf, sizeof(buf), "12 anchors (table)");
+
+    // Rejected sets.
+    HexSearch_t s;
+    static const uint8_t NO_ANCHOR[] = { 0x0F, 0xF0 };
+    HexPattern_t bad = { NODE, NO_ANCHOR, 2, NULL, 0, 0, ANSI_ErrLevel_NML };
+    CHECK(hexSearchInit(&s, &bad, 1) == -1, "pattern without a full byte accepted");
+    HexPattern_t empty = { NODE, NULL, 0, NULL, 0, 0, ANSI_ErrLevel_NML };
+    CHECK(hexSearchInit(&s, &empty, 1) == -1, "empty pattern accepted");
+
+    // Tagging: the sync word gets a colour and brackets, the preamble a warning.
+    uint8_t frame[256] = { 0 };
+    memcpy(frame + 10, PREAMBLE, 4);
+    memcpy(frame + 14, SYNC, 2);
+    memcpy(frame + 254, SYNC, 2);
+    HexPattern_t tags[] = {
+        { SYNC, NULL, 2, "\e[1;32m", '<', '>', ANSI_ErrLevel_NML },
+        { PREAMBLE, NULL, 4, NULL, 0, 0, ANSI_ErrLevel_WAN },
+    };
+    ANSIColorMap256_t clr = { 0 };
+    ANSIErrTagMap256_t tag = { 0 };
+    hexSearchInit(&s, tags, 2);
+    CHECK(hexSearchTag256(&s, frame, sizeof(frame), &clr, &tag) == 3, "tag hit count");
+    CHECK(clr.ansiColorStr[14] && clr.ansiColorStr[15] && !clr.ansiColorStr[13] && clr.charBegin[14] == '<' &&
+          clr.charEnd[15] == '>' && clr.ansiColorStr[255] && clr.charEnd[255] == '>', "colour map not tagged");
+    CHECK(tag.errLevel[10] == ANSI_ErrLevel_WAN && tag.errLevel[13] == ANSI_ErrLevel_WAN &&
+          tag.errLevel[14] == ANSI_ErrLevel_NML, "error map not tagged");
+
+    // Throughput over a larger capture.
+    size_t big_len = 64u << 20;
+    uint8_t *big = malloc(big_len);
+    for (size_t i = 0; i < big_len; i++) big[i] = (uint8_t)(i * 2654435761u >> 24);
+    hexSearchInit(&s, set, 4);
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    size_t hits = hexSearchScan(&s, big, big_len, NULL, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double sec = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    printf("hexSearch: %s, 4 patterns, %zu MB in %.1f ms (%.0f MB/s, %zu hits)\n",
+           cpuLevelName(cpuLevel()), big_len >> 20, sec * 1e3, (double)(big_len >> 20) / sec, hits);
+    free(big);
+
+    return test_report("hexSearch");
+}
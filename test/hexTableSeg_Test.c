@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <printHexTable/printHexTable.h>
+#include "testutil.h"
+
+static uint8_t frame[300];
+static ANSIColorMap256_t clr;
+static ANSIErrTagMap256_t tag;
+
+// Render frame[0, len) from the given segments and compare with the contiguous renderers.
+static void compare(const HexSeg_t *segs, size_t nsegs, size_t len, const char *what) {
+    char *want = printHexTable256(frame, len, what, "tail");
+    char *got = printHexTable256v(segs, nsegs, what, "tail");
+    CHECK(want && got && strcmp(want, got) == 0, "plain table differs: %s", what);
+    free(want);
+    free(got);
+
+    want = printColorHexTable256(frame, len, &clr, &tag, what, NULL);
+    got = printColorHexTable256v(segs, nsegs, &clr, &tag, what, NULL);
+    CHECK(want && got && strcmp(want, got) == 0, "color table differs: %s", what);
+    free(want);
+    free(got);
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(frame); i++) frame[i] = (uint8_t)(i * 37 + 5);
+    frame[20] = 0; frame[21] = '\n'; frame[22] = 0x1B;
+    addr2AnsiColorMap256(&clr, 14, 19, "\e[1;33m", 14, '[', 19, ']', 1);
+    addr2AnsiErrTag256(&tag, 30, 40, ANSI_ErrLevel_WAN);
+
+    // Header / payload / CRC, with boundaries inside rows and an empty segment.
+    HexSeg_t three[] = { { frame, 14 }, { frame + 14, 0 }, { frame + 14, 224 }, { frame + 238, 2 } };
+    compare(three, 4, 240, "header+payload+crc");
+
+    // One byte per segment: every row is gathered.
+    HexSeg_t bytes[256];
+    for (size_t i = 0; i < 256; i++) bytes[i] = (HexSeg_t){ frame + i, 1 };
+    compare(bytes, 256, 256, "1-byte segments");
+
+    // Row-aligned split: every row points straight into a segment.
+    HexSeg_t halves[] = { { frame, 128 }, { frame + 128, 172 } };
+    compare(halves, 2, 300, "longer than a table");
+
+    // Ring buffer holding the frame from offset 200, so the view wraps.
+    static uint8_t ring[256];
+    for (size_t i = 0; i < 180; i++) ring[(200 + i) % sizeof(ring)] = frame[i];
+    HexSeg_t view[2];
+    size_t n = hexRingView(view, ring, sizeof(ring), 200, 180);
+    CHECK(n == 2 && view[0].ptr == ring + 200 && view[0].len == 56 && view[1].ptr == ring && view[1].len == 124,
+          "hexRingView wrap: %zu segments", n);
+    compare(view, n, 180, "wrapped ring");
+
+    n = hexRingView(view, ring, sizeof(ring), 256 + 10, 20);
+    CHECK(n == 1 && view[0].ptr == ring + 10 && view[0].len == 20, "hexRingView no wrap");
+    CHECK(hexRingView(view, ring, 0, 0, 1) == 0, "hexRingView empty ring");
+
+    HexSeg_t none[] = { { NULL, 0 } };
+    compare(none, 1, 0, "empty");
+    HexSeg_t bad[] = { { frame, 4 }, { NULL, 4 } };
+    CHECK(printHexTable256v(bad, 2, NULL, NULL) == NULL, "segment without data accepted");
+    CHECK(printColorHexTable256v(NULL, 1, NULL, NULL, NULL, NULL) == NULL, "NULL segment list accepted");
+
+    return test_report("hexTableSeg");
+}
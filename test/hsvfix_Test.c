@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+static int worst888 = 0, worst565 = 0;
+
+// Fixed-point RGB against the float function rounded to nearest.
+static void compare(const char *name, float r, float g, float b, uint8_t R, uint8_t G, uint8_t B, uint16_t c565) {
+    uint8_t wr, wg, wb;
+    f01_2rgb888(r, g, b, &wr, &wg, &wb);
+    int e = abs(R - wr);
+    if (abs(G - wg) > e) e = abs(G - wg);
+    if (abs(B - wb) > e) e = abs(B - wb);
+    if (e > worst888) worst888 = e;
+
+    uint16_t w565 = f01_2rgb565(r, g, b);
+    int e5 = abs((c565 >> 11) - (w565 >> 11));
+    int eg = abs(((c565 >> 5) & 0x3F) - ((w565 >> 5) & 0x3F));
+    int eb = abs((c565 & 0x1F) - (w565 & 0x1F));
+    if (eg > e5) e5 = eg;
+    if (eb > e5) e5 = eb;
+    if (e5 > worst565) worst565 = e5;
+
+    if (e > 1 || e5 > 1) {
+        if (fail < 10) printf("%s: got %u,%u,%u / %04X want %u,%u,%u / %04X\n", name, R, G, B, c565, wr, wg, wb, w565);
+        fail++;
+    }
+}
+
+static float hue_err(float got, float want) {
+    float d = fabsf(got - want);
+    return d > 180.0f ? 360.0f - d : d;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec * 1e-6;
+}
+
+int main(void) {
+    float r, g, b;
+    uint8_t R, G, B;
+
+    // 8-bit inputs: every hue, a grid of saturation and value / lightness.
+    for (int h = 0; h < 256; h++) {
+        for (int s = 0; s < 256; s += 3) {
+            for (int v = 0; v < 256; v += 3) {
+                float hf = (float)h * 360.0f / 256.0f;
+                hsv2rgb(hf, s / 255.0f, v / 255.0f, &r, &g, &b);
+                hsv8_2rgb888((uint8_t)h, (uint8_t)s, (uint8_t)v, &R, &G, &B);
+                compare("hsv8", r, g, b, R, G, B, hsv8_2rgb565((uint8_t)h, (uint8_t)s, (uint8_t)v));
+
+                hsl2rgb(hf, s / 255.0f, v / 255.0f, &r, &g, &b);
+                hsl8_2rgb888((uint8_t)h, (uint8_t)s, (uint8_t)v, &R, &G, &B);
+                compare("hsl8", r, g, b, R, G, B, hsl8_2rgb565((uint8_t)h, (uint8_t)s, (uint8_t)v));
+            }
+        }
+    }
+
+    // 16-bit inputs at random.
+    srand(3);
+    for (int i = 0; i < 200000; i++) {
+        uint16_t h = (uint16_t)rand(), s = (uint16_t)rand(), v = (uint16_t)rand();
+        float hf = (float)h * 360.0f / 65536.0f;
+        hsv2rgb(hf, s / 65535.0f, v / 65535.0f, &r, &g, &b);
+        hsv16_2rgb888(h, s, v, &R, &G, &B);
+        compare("hsv16", r, g, b, R, G, B, hsv16_2rgb565(h, s, v));
+
+        hsl2rgb(hf, s / 65535.0f, v / 65535.0f, &r, &g, &b);
+        hsl16_2rgb888(h, s, v, &R, &G, &B);
+        compare("hsl16", r, g, b, R, G, B, hsl16_2rgb565(h, s, v));
+    }
+    printf("hsvfix: worst error %d LSB (RGB888), %d LSB (RGB565)\n", worst888, worst565);
+
+    // RGB -> HSV / HSL over a grid, against rgb2hsv / rgb2hsl; errors in LSBs of each format.
+    float worstHue = 0, worstSat = 0, worstVal = 0;
+    for (int ri = 0; ri < 256; ri += 5) {
+        for (int gi = 0; gi < 256; gi += 3) {
+            for (int bi = 0; bi < 256; bi += 7) {
+                float h, s, v, l;
+                uint16_t h16, s16, v16, l16;
+                uint8_t h8, s8, v8, l8;
+                rgb2hsv(ri / 255.0f, gi / 255.0f, bi / 255.0f, &h, &s, &v);
+                rgb888_2hsv16((uint8_t)ri, (uint8_t)gi, (uint8_t)bi, &h16, &s16, &v16);
+                rgb888_2hsv8((uint8_t)ri, (uint8_t)gi, (uint8_t)bi, &h8, &s8, &v8);
+                worstHue = fmaxf(worstHue, fmaxf(hue_err(h16 * 360.0f / 65536.0f, h) * 65536.0f / 360.0f,
+                                                 hue_err(h8 * 360.0f / 256.0f, h) * 256.0f / 360.0f));
+                worstSat = fmaxf(worstSat, fmaxf(fabsf(s16 - s * 65535.0f), fabsf(s8 - s * 255.0f)));
+                worstVal = fmaxf(worstVal, fmaxf(fabsf(v16 - v * 65535.0f), fabsf(v8 - v * 255.0f)));
+
+                rgb2hsl(ri / 255.0f, gi / 255.0f, bi / 255.0f, &h, &s, &l);
+                rgb888_2hsl16((uint8_t)ri, (uint8_t)gi, (uint8_t)bi, &h16, &s16, &l16);
+                rgb888_2hsl8((uint8_t)ri, (uint8_t)gi, (uint8_t)bi, &h8, &s8, &l8);
+                worstHue = fmaxf(worstHue, fmaxf(hue_err(h16 * 360.0f / 65536.0f, h) * 65536.0f / 360.0f,
+                                                 hue_err(h8 * 360.0f / 256.0f, h) * 256.0f / 360.0f));
+                worstSat = fmaxf(worstSat, fmaxf(fabsf(s16 - s * 65535.0f), fabsf(s8 - s * 255.0f)));
+                worstVal = fmaxf(worstVal, fmaxf(fabsf(l16 - l * 65535.0f), fabsf(l8 - l * 255.0f)));
+            }
+        }
+    }
+    printf("hsvfix: inverse worst hue %.2f, saturation %.2f, value/lightness %.2f LSB\n", worstHue, worstSat, worstVal);
+    CHECK(worstHue <= 1.0f && worstSat <= 1.0f && worstVal <= 1.0f, "inverse conversions off by more than one LSB");
+
+    // Round trip through the 16-bit forms is lossless for RGB888.
+    int roundTrip = 0;
+    for (int c = 0; c < (1 << 24); c += 97) {
+        uint16_t h, s, v;
+        rgb888_2hsv16((uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c, &h, &s, &v);
+        hsv16_2rgb888(h, s, v, &R, &G, &B);
+        roundTrip += (R != (uint8_t)(c >> 16) || G != (uint8_t)(c >> 8) || B != (uint8_t)c);
+        rgb888_2hsl16((uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c, &h, &s, &v);
+        hsl16_2rgb888(h, s, v, &R, &G, &B);
+        roundTrip += (R != (uint8_t)(c >> 16) || G != (uint8_t)(c >> 8) || B != (uint8_t)c);
+    }
+    CHECK(roundTrip == 0, "%d colours changed on a 16-bit round trip", roundTrip);
+
+    // Batches match the scalar functions.
+    enum { LEDS = 300 };
+    static uint8_t in[LEDS * 3], out[LEDS * 3];
+    static uint16_t out565[LEDS];
+    for (int i = 0; i < LEDS * 3; i++) in[i] = (uint8_t)(i * 37 + 11);
+    hsv8_2rgb888_batch(in, out, LEDS);
+    hsv8_2rgb565_batch(in, out565, LEDS);
+    int bad = 0;
+    for (int i = 0; i < LEDS; i++) {
+        hsv8_2rgb888(in[3 * i], in[3 * i + 1], in[3 * i + 2], &R, &G, &B);
+        bad += (R != out[3 * i] || G != out[3 * i + 1] || B != out[3 * i + 2]);
+        bad += out565[i] != hsv8_2rgb565(in[3 * i], in[3 * i + 1], in[3 * i + 2]);
+    }
+    hsl8_2rgb888_batch(in, out, LEDS);
+    hsl8_2rgb565_batch(in, out565, LEDS);
+    for (int i = 0; i < LEDS; i++) {
+        hsl8_2rgb888(in[3 * i], in[3 * i + 1], in[3 * i + 2], &R, &G, &B);
+        bad += (R != out[3 * i] || G != out[3 * i + 1] || B != out[3 * i + 2]);
+        bad += out565[i] != hsl8_2rgb565(in[3 * i], in[3 * i + 1], in[3 * i + 2]);
+    }
+    CHECK(bad == 0, "%d batch pixels differ from the scalar functions", bad);
+
+    // A rainbow animation over the strip, fixed point against float.
+    const int frames = 20000;
+    double t0 = now_ms();
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < LEDS; i++) in[3 * i] = (uint8_t)(i + f), in[3 * i + 1] = 255, in[3 * i + 2] = 200;
+        hsv8_2rgb888_batch(in, out, LEDS);
+    }
+    double t1 = now_ms();
+    volatile uint8_t sink = 0;
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < LEDS; i++) {
+            hsv2rgb((float)((i + f) & 255) * 360.0f / 256.0f, 1.0f, 200 / 255.0f, &r, &g, &b);
+            f01_2rgb888(r, g, b, &out[3 * i], &out[3 * i + 1], &out[3 * i + 2]);
+        }
+        sink ^= out[0];
+    }
+    double t2 = now_ms();
+    (void)sink;
+    printf("hsvfix: %d-LED frame in %.2f us fixed point, %.2f us float\n", LEDS, (t1 - t0) * 1e3 / frames,
+           (t2 - t1) * 1e3 / frames);
+
+    return test_report("hsvfix");
+}
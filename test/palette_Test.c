@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+static uint8_t brute(const uint8_t *rgb, size_t n, uint8_t r, uint8_t g, uint8_t b) {
+    uint32_t best = UINT32_MAX;
+    uint8_t idx = 0;
+    for (size_t i = 0; i < n; i++) {
+        int dr = rgb[3 * i] - r, dg = rgb[3 * i + 1] - g, db = rgb[3 * i + 2] - b;
+        uint32_t d = (uint32_t)(2 * dr * dr + 4 * dg * dg + 3 * db * db);
+        if (d < best) {
+            best = d;
+            idx = (uint8_t)i;
+        }
+    }
+    return idx;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec * 1e-6;
+}
+
+#define PIXELS (1 << 20)
+
+static uint8_t img[PIXELS * 3];
+static uint8_t got[PIXELS], want[PIXELS];
+
+static void run(const char *name, const uint8_t *rgb, size_t n) {
+    palette_t pal;
+    CHECK(paletteInit(&pal, rgb, n) == 0, "%s: paletteInit", name);
+
+    double t0 = now_ms();
+    paletteMapRGB888(&pal, img, got, PIXELS);
+    double t1 = now_ms();
+    for (size_t i = 0; i < PIXELS; i++) want[i] = brute(rgb, n, img[3 * i], img[3 * i + 1], img[3 * i + 2]);
+    double t2 = now_ms();
+    int bad = 0;
+    for (size_t i = 0; i < PIXELS; i++) bad += got[i] != want[i];
+    CHECK(bad == 0, "%s: %d pixels differ from brute force", name, bad);
+
+    // Palette entries map to themselves (or an earlier duplicate).
+    for (size_t i = 0; i < n; i++) {
+        uint8_t k = paletteNearest(&pal, rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+        CHECK(memcmp(&rgb[3 * k], &rgb[3 * i], 3) == 0 && k <= i, "%s: entry %zu maps to %u", name, i, k);
+    }
+
+    uint16_t src565[256];
+    uint8_t idx565[256];
+    for (int i = 0; i < 256; i++) src565[i] = (uint16_t)(i * 257 + 11);
+    paletteMapRGB565(&pal, src565, idx565, 256);
+    for (int i = 0; i < 256; i++) {
+        uint8_t r, g, b;
+        rgb565_2rgb888(src565[i], &r, &g, &b);
+        CHECK(idx565[i] == brute(rgb, n, r, g, b), "%s: RGB565 pixel %d", name, i);
+    }
+
+    printf("palette: %-10s %3zu colours  %5.1f Mpix/s LUT  %5.1f Mpix/s brute force  (%.1fx)  %u candidates\n", name, n,
+           PIXELS / (t1 - t0) / 1e3, PIXELS / (t2 - t1) / 1e3, (t2 - t1) / (t1 - t0), pal.cellStart[16 * 16 * 16]);
+    paletteFree(&pal);
+}
+
+int main(void) {
+    srand(5);
+    for (size_t i = 0; i < sizeof(img); i++) img[i] = (uint8_t)rand();
+
+    static const uint8_t EPAPER7[] = {
+        0, 0, 0,   255, 255, 255,   0, 255, 0,   0, 0, 255,   255, 0, 0,   255, 255, 0,   255, 128, 0,
+    };
+    static const uint8_t VGA16[] = {
+        0, 0, 0,       128, 0, 0,     0, 128, 0,     128, 128, 0,   0, 0, 128,     128, 0, 128,
+        0, 128, 128,   192, 192, 192, 128, 128, 128, 255, 0, 0,     0, 255, 0,     255, 255, 0,
+        0, 0, 255,     255, 0, 255,   0, 255, 255,   255, 255, 255,
+    };
+    static uint8_t random256[256 * 3], ansi256[256 * 3], dup[6 * 3];
+    for (size_t i = 0; i < sizeof(random256); i++) random256[i] = (uint8_t)rand();
+    // xterm 256-colour palette: 16 system colours, a 6x6x6 cube, 24 grays.
+    static const uint8_t CUBE[6] = { 0, 95, 135, 175, 215, 255 };
+    memcpy(ansi256, VGA16, sizeof(VGA16));
+    for (int i = 0; i < 216; i++) {
+        ansi256[3 * (16 + i)] = CUBE[i / 36];
+        ansi256[3 * (16 + i) + 1] = CUBE[i / 6 % 6];
+        ansi256[3 * (16 + i) + 2] = CUBE[i % 6];
+    }
+    for (int i = 0; i < 24; i++) memset(&ansi256[3 * (232 + i)], 8 + 10 * i, 3);
+    for (int i = 0; i < 6; i++) memcpy(&dup[3 * i], &EPAPER7[3 * (i % 3)], 3);   // repeated entries
+
+    run("e-paper", EPAPER7, 7);
+    run("vga16", VGA16, 16);
+    run("xterm256", ansi256, 256);
+    run("random256", random256, 256);
+    run("duplicates", dup, 6);
+
+    palette_t pal;
+    CHECK(paletteInit(&pal, EPAPER7, 0) == -1 && paletteInit(&pal, EPAPER7, 257) == -1 && paletteInit(NULL, EPAPER7, 7) == -1,
+          "bad palette accepted");
+    // A palette whose init failed is zeroed, and lookups on it are no-ops.
+    uint8_t idx[4] = { 9, 9, 9, 9 };
+    uint16_t px565[4] = { 0 };
+    CHECK(paletteNearest(&pal, 1, 2, 3) == 0 && paletteNearest(NULL, 1, 2, 3) == 0, "nearest on failed palette");
+    paletteMapRGB888(&pal, img, idx, 4);
+    paletteMapRGB565(&pal, px565, idx, 4);
+    paletteMapRGB888(NULL, img, idx, 4);
+    CHECK(idx[0] == 9 && idx[3] == 9, "map on failed palette wrote output");
+
+    // Dithering: a 50% gray field on black and white averages out to gray,
+    // and an image made of palette colours passes through untouched.
+    enum { W = 64, H = 64 };
+    static uint8_t gray[W * H * 3], out[W * H];
+    memset(gray, 128, sizeof(gray));
+    paletteInit(&pal, EPAPER7, 2);
+    CHECK(paletteDitherRGB888(&pal, out, 0, gray, 0, W, H) == 0, "paletteDitherRGB888");
+    int white = 0;
+    for (int i = 0; i < W * H; i++) white += out[i] == 1;
+    CHECK(white > W * H * 45 / 100 && white < W * H * 55 / 100, "dithered gray is %d/%d white", white, W * H);
+    paletteFree(&pal);
+
+    paletteInit(&pal, EPAPER7, 7);
+    static uint8_t exact[W * H * 3], strided[H][W + 5];
+    for (int i = 0; i < W * H; i++) memcpy(&exact[3 * i], &EPAPER7[3 * (i * 5 % 7)], 3);
+    paletteDitherRGB888(&pal, &strided[0][0], W + 5, exact, 0, W, H);
+    int bad = 0;
+    for (int i = 0; i < W * H; i++) bad += strided[i / W][i % W] != i * 5 % 7;
+    CHECK(bad == 0, "dithering changed %d exact pixels", bad);
+
+    double t0 = now_ms();
+    paletteDitherRGB888(&pal, got, 1024, img, 0, 1024, PIXELS / 1024);
+    printf("palette: dither 7 colours %.1f Mpix/s\n", PIXELS / (now_ms() - t0) / 1e3);
+    paletteFree(&pal);
+
+    return test_report("palette");
+}
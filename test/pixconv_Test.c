@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+#define W 37   // odd width, so GRAY1 rows end in a partial byte
+#define H 5
+#define PAD 8  // row padding in bytes
+
+static const char *NAMES[PIXFMT_COUNT] = { "ARGB32", "RGBA32", "RGB565", "RGB888", "F01", "GRAY8", "GRAY1" };
+
+typedef struct {
+    pixfmt_t fmt;
+    uint8_t r, g, b, a;   // 8-bit view (ARGB32, RGBA32, RGB888, GRAY8, GRAY1)
+    uint16_t p565;
+    float f[3];
+} refpix_t;
+
+static refpix_t ref_read(pixfmt_t fmt, const uint8_t *row, size_t x) {
+    refpix_t p = { .fmt = fmt, .a = 0xFF };
+    switch (fmt) {
+    case PIXFMT_ARGB32: { ARGB32_t v; memcpy(&v, row + 4 * x, 4);
+        p.a = ARGB32_GET_A(v); p.r = ARGB32_GET_R(v); p.g = ARGB32_GET_G(v); p.b = ARGB32_GET_B(v); break; }
+    case PIXFMT_RGBA32: { RGBA32_t v; memcpy(&v, row + 4 * x, 4);
+        p.a = RGBA32_GET_A(v); p.r = RGBA32_GET_R(v); p.g = RGBA32_GET_G(v); p.b = RGBA32_GET_B(v); break; }
+    case PIXFMT_RGB565: memcpy(&p.p565, row + 2 * x, 2); break;
+    case PIXFMT_RGB888: p.r = row[3 * x]; p.g = row[3 * x + 1]; p.b = row[3 * x + 2]; break;
+    case PIXFMT_F01: memcpy(p.f, row + 12 * x, 12); break;
+    case PIXFMT_GRAY8: p.r = p.g = p.b = row[x]; break;
+    case PIXFMT_GRAY1: p.r = p.g = p.b = ((row[x >> 3] >> (7 - (x & 7))) & 1) ? 255 : 0; break;
+    default: break;
+    }
+    return p;
+}
+
+// Chain of the single-pixel functions.
+static void ref_rgb8(const refpix_t *p, uint8_t *r, uint8_t *g, uint8_t *b) {
+    if (p->fmt == PIXFMT_RGB565) rgb565_2rgb888(p->p565, r, g, b);
+    else if (p->fmt == PIXFMT_F01) f01_2rgb888(p->f[0], p->f[1], p->f[2], r, g, b);
+    else { *r = p->r; *g = p->g; *b = p->b; }
+}
+
+static uint8_t ref_gray(const refpix_t *p) {
+    uint8_t r, g, b;
+    if (p->fmt == PIXFMT_RGB565) return rgb565_2gray(p->p565);
+    ref_rgb8(p, &r, &g, &b);
+    return rgb888_2gray(r, g, b);
+}
+
+static void ref_write(pixfmt_t fmt, uint8_t *row, size_t x, const refpix_t *p) {
+    uint8_t r, g, b;
+    ref_rgb8(p, &r, &g, &b);
+    switch (fmt) {
+    case PIXFMT_ARGB32: { ARGB32_t v = ARGB32_GET(p->a, r, g, b); memcpy(row + 4 * x, &v, 4); break; }
+    case PIXFMT_RGBA32: { RGBA32_t v = ((uint32_t)r << 24) | RGBA32_GET(0u, g, b, p->a); memcpy(row + 4 * x, &v, 4); break; }
+    case PIXFMT_RGB565: {
+        uint16_t v = (p->fmt == PIXFMT_RGB565) ? p->p565 :
+                     (p->fmt == PIXFMT_F01) ? f01_2rgb565(p->f[0], p->f[1], p->f[2]) : rgb888_2rgb565(r, g, b);
+        memcpy(row + 2 * x, &v, 2);
+        break;
+    }
+    case PIXFMT_RGB888: row[3 * x] = r; row[3 * x + 1] = g; row[3 * x + 2] = b; break;
+    case PIXFMT_F01: {
+        float f[3];
+        if (p->fmt == PIXFMT_F01) memcpy(f, p->f, 12);
+        else if (p->fmt == PIXFMT_RGB565) rgb565_2f01(p->p565, &f[0], &f[1], &f[2]);
+        else rgb888_2f01(r, g, b, &f[0], &f[1], &f[2]);
+        memcpy(row + 12 * x, f, 12);
+        break;
+    }
+    case PIXFMT_GRAY8: row[x] = ref_gray(p); break;
+    case PIXFMT_GRAY1: {
+        uint8_t bit = (uint8_t)(0x80 >> (x & 7));
+        row[x >> 3] = gray2_1bit(ref_gray(p)) ? (row[x >> 3] | bit) : (row[x >> 3] & ~bit);
+        break;
+    }
+    default: break;
+    }
+}
+
+static void fill(pixfmt_t fmt, uint8_t *img, size_t stride) {
+    for (size_t y = 0; y < H; y++) {
+        uint8_t *row = img + y * stride;
+        if (fmt == PIXFMT_F01) {
+            float *f = (float *)row;
+            for (size_t i = 0; i < 3 * W; i++) f[i] = (float)rand() / RAND_MAX * 1.2f - 0.1f;
+        } else {
+            for (size_t i = 0; i < pixfmtRowBytes(fmt, W); i++) row[i] = (uint8_t)rand();
+        }
+    }
+}
+
+// GRAY1 padding bits past the last pixel of a row are unspecified.
+static void mask_pad(pixfmt_t fmt, uint8_t *img, size_t stride) {
+    if (fmt != PIXFMT_GRAY1 || (W & 7) == 0) return;
+    for (size_t y = 0; y < H; y++) img[y * stride + W / 8] &= (uint8_t)(0xFF << (8 - (W & 7)));
+}
+
+// One row of every length up to 200 for the pairs with vector bodies, so each
+// level's vector part and scalar tail split at every offset; the byte after
+// the row must stay untouched.
+static void check_lengths(void) {
+    static const pixfmt_t PAIRS[][2] = {
+        { PIXFMT_RGB888, PIXFMT_RGB565 }, { PIXFMT_RGB565, PIXFMT_RGB888 }, { PIXFMT_RGB888, PIXFMT_GRAY8 },
+        { PIXFMT_RGB565, PIXFMT_GRAY8 },  { PIXFMT_RGB888, PIXFMT_GRAY1 },  { PIXFMT_RGB565, PIXFMT_GRAY1 },
+    };
+    static uint8_t src[200 * 3], got[200 * 3 + 1], want[200 * 3 + 1];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)rand();
+    for (int k = 0; k < 6; k++) {
+        pixfmt_t sf = PAIRS[k][0], df = PAIRS[k][1];
+        for (size_t n = 1; n <= 200; n++) {
+            memset(got, 0x5A, sizeof(got));
+            memset(want, 0x5A, sizeof(want));
+            for (size_t x = 0; x < n; x++) {
+                refpix_t p = ref_read(sf, src, x);
+                ref_write(df, want, x, &p);
+            }
+            size_t bytes = pixfmtRowBytes(df, n);
+            int rc = pixconv(got, df, 0, src, sf, 0, n, 1);
+            CHECK(rc == 0 && memcmp(got, want, bytes + 1) == 0, "%s -> %s n=%zu: mismatch", NAMES[sf], NAMES[df], n);
+        }
+    }
+}
+
+int main(void) {
+    int rc = test_each_cpu_level();
+    if (rc >= 0) return rc;
+    static uint32_t srcbuf[H * (W * 12 + PAD) / 4 + 1], gotbuf[H * (W * 12 + PAD) / 4 + 1], wantbuf[H * (W * 12 + PAD) / 4 + 1];
+    uint8_t *src = (uint8_t *)srcbuf, *got = (uint8_t *)gotbuf, *want = (uint8_t *)wantbuf;
+    srand(7);
+
+    for (int sf = 0; sf < PIXFMT_COUNT; sf++) {
+        for (int df = 0; df < PIXFMT_COUNT; df++) {
+            size_t ss = pixfmtRowBytes(sf, W) + PAD, ds = pixfmtRowBytes(df, W) + PAD;
+            fill(sf, src, ss);
+            memset(got, 0xAA, sizeof(gotbuf));
+            memset(want, 0xAA, sizeof(wantbuf));
+            for (size_t y = 0; y < H; y++)
+                for (size_t x = 0; x < W; x++) {
+                    refpix_t p = ref_read(sf, src + y * ss, x);
+                    ref_write(df, want + y * ds, x, &p);
+                }
+            rc = pixconv(got, df, ds, src, sf, ss, W, H);
+            mask_pad(df, got, ds);
+            mask_pad(df, want, ds);
+            CHECK(rc == 0 && memcmp(got, want, H * ds) == 0, "%s -> %s: mismatch", NAMES[sf], NAMES[df]);
+        }
+    }
+    check_lengths();
+
+    // In place, shrinking RGB888 -> RGB565 with the same stride.
+    fill(PIXFMT_RGB888, src, W * 3 + PAD);
+    memcpy(got, src, sizeof(srcbuf));
+    pixconv(want, PIXFMT_RGB565, W * 3 + PAD, src, PIXFMT_RGB888, W * 3 + PAD, W, H);
+    CHECK(pixconv(got, PIXFMT_RGB565, W * 3 + PAD, got, PIXFMT_RGB888, W * 3 + PAD, W, H) == 0, "in place refused");
+    for (size_t y = 0; y < H; y++)
+        CHECK(memcmp(got + y * (W * 3 + PAD), want + y * (W * 3 + PAD), W * 2) == 0, "in-place mismatch in row %zu", y);
+    // Growing in place is refused.
+    CHECK(pixconv(got, PIXFMT_ARGB32, 0, got, PIXFMT_RGB565, 0, W, H) != 0, "grow in place accepted");
+
+    // Timing: camera RGB888 -> LCD RGB565 and -> 1bpp OLED, engine vs per-pixel calls.
+    enum { BW = 640, BH = 480, LOOPS = 50 };
+    uint8_t *cam = malloc(BW * BH * 3);
+    uint16_t *lcd = malloc(BW * BH * 2);
+    uint8_t *oled = malloc(BW * BH / 8);
+    for (size_t i = 0; i < BW * BH * 3; i++) cam[i] = (uint8_t)rand();
+    pixconv(lcd, PIXFMT_RGB565, 0, cam, PIXFMT_RGB888, 0, BW, BH);   // touch the pages before timing
+    pixconv(oled, PIXFMT_GRAY1, 0, cam, PIXFMT_RGB888, 0, BW, BH);
+    clock_t t0 = clock();
+    for (int l = 0; l < LOOPS; l++)
+        for (size_t i = 0; i < BW * BH; i++) lcd[i] = rgb888_2rgb565(cam[3 * i], cam[3 * i + 1], cam[3 * i + 2]);
+    clock_t t1 = clock();
+    for (int l = 0; l < LOOPS; l++) pixconv(lcd, PIXFMT_RGB565, 0, cam, PIXFMT_RGB888, 0, BW, BH);
+    clock_t t2 = clock();
+    for (int l = 0; l < LOOPS; l++)
+        for (size_t i = 0; i < BW * BH; i += 8) {
+            uint8_t byte = 0;
+            for (size_t k = 0; k < 8; k++)
+                byte = (uint8_t)((byte << 1) | gray2_1bit(rgb888_2gray(cam[3 * (i + k)], cam[3 * (i + k) + 1], cam[3 * (i + k) + 2])));
+            oled[i / 8] = byte;
+        }
+    clock_t t3 = clock();
+    for (int l = 0; l < LOOPS; l++) pixconv(oled, PIXFMT_GRAY1, 0, cam, PIXFMT_RGB888, 0, BW, BH);
+    clock_t t4 = clock();
+    printf("RGB888->RGB565 %dx%d x%d: per-pixel %.1f ms, pixconv %.1f ms\n", BW, BH, LOOPS,
+           (t1 - t0) * 1000.0 / CLOCKS_PER_SEC, (t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+    printf("RGB888->GRAY1  %dx%d x%d: per-pixel %.1f ms, pixconv %.1f ms\n", BW, BH, LOOPS,
+           (t3 - t2) * 1000.0 / CLOCKS_PER_SEC, (t4 - t3) * 1000.0 / CLOCKS_PER_SEC);
+    free(cam);
+    free(lcd);
+    free(oled);
+
+    char name[32];
+    snprintf(name, sizeof(name), "pixconv [%s]", cpuLevelName(cpuLevel()));
+    return test_report(name);
+}
@@ -0,0 +1,84 @@
+// Needs libraries built with `make STATS=1`; reports SKIP otherwise.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <statUtils/statutl.h>
+#include <printfUtils/printfutl.h>
+#include <printHexTable/printHexTable.h>
+#include <colorUtils/colorutl.h>
+#include "testutil.h"
+
+static void *worker(void *arg) {
+    (void)arg;
+    char *s = NULL;
+    for (int i = 0; i < 10; i++) sappendf(&s, "%d", i);   // 10 bytes, 1 alloc, 9 reallocs
+    free(s);
+    return NULL;
+}
+
+int main(void) {
+    if (!statEnabled()) {
+        printf("statutl: SKIP (libraries built without RADIO_UTILS_STATS)\n");
+        return 0;
+    }
+
+    stat_snapshot_t snap;
+    statReset();
+    statResetThread();
+
+    char *s = NULL;
+    sappendf(&s, "abc");
+    sappendf(&s, "%s", "de");
+    free(s);
+    statSnapshotThread(&snap);
+    const stat_counter_t *c = &snap.c[STAT_SAPPENDF];
+    CHECK(c->calls == 2 && c->bytes == 5 && c->allocs == 1 && c->reallocs == 1,
+          "sappendf: calls %llu bytes %llu allocs %llu reallocs %llu",
+          (unsigned long long)c->calls, (unsigned long long)c->bytes,
+          (unsigned long long)c->allocs, (unsigned long long)c->reallocs);
+
+    uint8_t buf[256];
+    for (int i = 0; i < 256; i++) buf[i] = (uint8_t)i;
+    char *t = printHexTable256(buf, sizeof(buf), "stats", NULL);
+    size_t tlen = strlen(t);
+    free(t);
+    statSnapshotThread(&snap);
+    c = &snap.c[STAT_HEXTABLE256];
+    CHECK(c->calls == 1 && c->bytes == tlen && c->allocs > 0 && c->ns > 0,
+          "printHexTable256: calls %llu bytes %llu (want %zu) allocs %llu",
+          (unsigned long long)c->calls, (unsigned long long)c->bytes, tlen, (unsigned long long)c->allocs);
+    CHECK(snap.c[STAT_SAPPENDF].calls > 2, "nested sappendf calls not counted");
+
+    float h[5] = { 0, 60, 120, 180, 240 }, sv[5] = { 1, 1, 1, 1, 1 }, r[5], g[5], b[5];
+    hsv2rgb_batch(h, sv, sv, r, g, b, 5);
+    statSnapshotThread(&snap);
+    c = &snap.c[STAT_HSV2RGB_BATCH];
+    CHECK(c->calls == 1 && c->bytes == 5 * 3 * sizeof(float), "hsv2rgb_batch: calls %llu bytes %llu",
+          (unsigned long long)c->calls, (unsigned long long)c->bytes);
+
+    // An exited thread's counters stay in the aggregate.
+    stat_snapshot_t before, after;
+    statSnapshot(&before);
+    pthread_t th;
+    pthread_create(&th, NULL, worker, NULL);
+    pthread_join(th, NULL);
+    statSnapshot(&after);
+    CHECK(after.c[STAT_SAPPENDF].calls - before.c[STAT_SAPPENDF].calls == 10 &&
+          after.c[STAT_SAPPENDF].bytes - before.c[STAT_SAPPENDF].bytes == 10 &&
+          after.c[STAT_SAPPENDF].reallocs - before.c[STAT_SAPPENDF].reallocs == 9,
+          "worker thread: calls +%llu",
+          (unsigned long long)(after.c[STAT_SAPPENDF].calls - before.c[STAT_SAPPENDF].calls));
+
+    statReset();
+    statSnapshot(&snap);
+    CHECK(snap.c[STAT_SAPPENDF].calls == 0 && snap.c[STAT_HEXTABLE256].calls == 0, "statReset");
+    statResetThread();
+    statSnapshotThread(&snap);
+    CHECK(snap.c[STAT_HSV2RGB_BATCH].calls == 0, "statResetThread");
+
+    for (int i = 0; i < STAT_COUNT; i++) CHECK(strcmp(statName((stat_id_t)i), "unknown") != 0, "statName %d", i);
+
+    return test_report("statutl");
+}
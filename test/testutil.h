@@ -0,0 +1,45 @@
+#ifndef RADIO_UTILS_TESTUTIL_H
+#define RADIO_UTILS_TESTUTIL_H
+
+// Shared by the test programs: CHECK() prints the message and counts a
+// failure, test_report() prints "name: OK (0 failures)" (or FAIL) and
+// returns the exit status for main().
+
+#include <stdio.h>
+
+static int fail = 0;
+
+#define CHECK(cond, ...) do { if (!(cond)) { printf(__VA_ARGS__); printf("\n"); fail++; } } while (0)
+
+static inline int test_report(const char *name) {
+    printf("%s: %s (%d failures)\n", name, fail ? "FAIL" : "OK", fail);
+    return fail ? 1 : 0;
+}
+
+#ifdef COLORUTL_H
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Runs the rest of the test once per SIMD level this CPU has, each in a
+// forked child with RADIO_UTILS_CPU set (cpuLevel() is picked once per
+// process). Returns -1 in a process that should run the checks, otherwise
+// main()'s exit status. A level set by the caller is left alone.
+static inline int test_each_cpu_level(void) {
+    if (getenv("RADIO_UTILS_CPU")) return -1;
+    fflush(stdout);
+    int status = 0;
+    for (int lvl = CPU_LEVEL_SCALAR; lvl <= (int)cpuLevelSupported(); lvl++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            setenv("RADIO_UTILS_CPU", cpuLevelName((cpu_level_t)lvl), 1);
+            return -1;
+        }
+        int st = 0;
+        if (pid < 0 || waitpid(pid, &st, 0) != pid || !WIFEXITED(st) || WEXITSTATUS(st) != 0) status = 1;
+    }
+    return status;
+}
+#endif
+
+#endif
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <printfUtils/printfutl.h>
+#include "testutil.h"
+
+// Pipe reader standing in for the console; it stalls until `go` is set.
+typedef struct {
+    int fd;
+    int go;
+    char *data;
+    size_t len;
+} sink_t;
+
+static void *sink_main(void *arg) {
+    sink_t *s = (sink_t *)arg;
+    size_t cap = 1 << 20;
+    s->data = malloc(cap);
+    while (!__atomic_load_n(&s->go, __ATOMIC_ACQUIRE)) usleep(1000);
+    for (;;) {
+        if (s->len + 65536 > cap) s->data = realloc(s->data, cap *= 2);
+        ssize_t r = read(s->fd, s->data + s->len, 65536);
+        if (r <= 0) break;
+        s->len += (size_t)r;
+    }
+    s->data[s->len] = '\0';
+    return NULL;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec * 1e-6;
+}
+
+static char *message(int i) {
+    char *s = NULL;
+    sappendf(&s, "msg %05d %0999d\n", i, 0);   // about 1 KiB, like a small table
+    return s;
+}
+
+// Messages must appear in submission order; returns how many, plus the last index seen.
+static int check_order(const char *out, int *last) {
+    int n = 0, prev = -1;
+    for (const char *p = out; (p = strstr(p, "msg ")); p++) {
+        int i = atoi(p + 4);
+        if (i <= prev) return -1;
+        prev = i;
+        n++;
+    }
+    *last = prev;
+    return n;
+}
+
+static void run(utl_writer_policy_t policy, int stall, const char *name) {
+    int fds[2];
+    if (pipe(fds) != 0) return;
+    sink_t sink = { fds[0], !stall, NULL, 0 };
+    pthread_t th;
+    pthread_create(&th, NULL, sink_main, &sink);
+
+    utl_writer_t *w = utlWriterOpen(fds[1], 3, 16 * 1024, policy);
+    const int N = 2000;
+    double worst = 0;
+    for (int i = 0; i < N; i++) {
+        double t0 = now_ms();
+        utlWriterSubmit(w, message(i));
+        double dt = now_ms() - t0;
+        if (dt > worst) worst = dt;
+        if (!stall && i % 32 == 31) utlWriterFlush(w);   // a producer that keeps pace never drops
+    }
+    __atomic_store_n(&sink.go, 1, __ATOMIC_RELEASE);
+    utlWriterFlush(w);
+    utl_writer_stats_t st;
+    utlWriterStats(w, &st);
+    utlWriterClose(w);
+    close(fds[1]);
+    pthread_join(th, NULL);
+    close(fds[0]);
+
+    int last = -1;
+    int seen = check_order(sink.data, &last);
+    bool summary = strstr(sink.data, "dropped ...]") != NULL;
+    CHECK(st.submitted == (uint64_t)N && st.written + st.dropped == (uint64_t)N && seen == (int)st.written,
+          "%s: submitted %llu written %llu dropped %llu seen %d", name, (unsigned long long)st.submitted,
+          (unsigned long long)st.written, (unsigned long long)st.dropped, seen);
+    CHECK(worst < 50.0, "%s: producer blocked for %.1f ms", name, worst);
+    if (stall) {
+        CHECK(st.dropped > 0, "%s: a stalled console dropped nothing", name);
+        if (policy == UTL_WRITER_DROP_OLDEST) CHECK(last == N - 1, "%s: newest message lost", name);
+        if (policy == UTL_WRITER_DROP_NEWEST) CHECK(last < N - 1, "%s: newest message kept", name);
+        CHECK(summary == (policy == UTL_WRITER_SUMMARY) && (st.summaries > 0) == summary,
+              "%s: summary line %s", name, summary ? "unexpected" : "missing");
+    } else {
+        CHECK(st.dropped == 0 && sink.len == st.bytes, "%s: drops without a stall", name);
+    }
+    printf("writerutl: %-12s %s  written %4llu dropped %4llu batches %3llu worst submit %.3f ms\n", name,
+           stall ? "stalled" : "live   ", (unsigned long long)st.written, (unsigned long long)st.dropped,
+           (unsigned long long)st.batches, worst);
+    free(sink.data);
+}
+
+// Strings rendered into a per-thread arena that is reset (and scribbled
+// over) straight after submitting still come out intact: the writer keeps
+// its own copies and never calls back into the arena from its thread.
+static void arena_submit(void) {
+    int fds[2];
+    if (pipe(fds) != 0) return;
+    sink_t sink = { fds[0], 0, NULL, 0 };
+    pthread_t th;
+    pthread_create(&th, NULL, sink_main, &sink);
+
+    static uint8_t mem[4096];
+    utl_arena_t arena;
+    utlArenaInit(&arena, mem, sizeof(mem));
+    const utl_allocator_t *prev = utlSetThreadAllocator(&arena.allocator);
+    utl_writer_t *w = utlWriterOpen(fds[1], 2, 0, UTL_WRITER_DROP_NEWEST);
+    const int N = 20;
+    for (int i = 0; i < N; i++) {
+        char *s = NULL;
+        sappendf(&s, "msg %05d arena\n", i);
+        CHECK(s && utlWriterSubmit(w, s) == 0, "arena: submit %d", i);
+        utlArenaReset(&arena);
+        memset(mem, 'x', sizeof(mem));
+    }
+    utlSetThreadAllocator(prev);
+    __atomic_store_n(&sink.go, 1, __ATOMIC_RELEASE);
+    utlWriterClose(w);
+    close(fds[1]);
+    pthread_join(th, NULL);
+    close(fds[0]);
+
+    int last = -1;
+    CHECK(check_order(sink.data, &last) == N && last == N - 1 && !strchr(sink.data, 'x'),
+          "arena: output corrupted");
+    free(sink.data);
+}
+
+// A counting allocator that is not the libc default: every string goes back
+// through it before Submit returns, whether it was queued or dropped.
+static int live_allocs;
+
+static void *count_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    __atomic_add_fetch(&live_allocs, 1, __ATOMIC_RELAXED);
+    return malloc(size);
+}
+
+static void *count_realloc(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    if (!ptr) __atomic_add_fetch(&live_allocs, 1, __ATOMIC_RELAXED);
+    return realloc(ptr, size);
+}
+
+static void count_free(void *ctx, void *ptr) {
+    (void)ctx;
+    if (ptr) __atomic_sub_fetch(&live_allocs, 1, __ATOMIC_RELAXED);
+    free(ptr);
+}
+
+static void custom_submit(utl_writer_policy_t policy, const char *name) {
+    int fds[2];
+    if (pipe(fds) != 0) return;
+    sink_t sink = { fds[0], 0, NULL, 0 };
+    pthread_t th;
+    pthread_create(&th, NULL, sink_main, &sink);
+
+    static const utl_allocator_t counting = { count_alloc, count_realloc, count_free, NULL };
+    const utl_allocator_t *prev = utlSetThreadAllocator(&counting);
+    utl_writer_t *w = utlWriterOpen(fds[1], 2, 16 * 1024, policy);
+    const int N = 500;
+    int held = 0;
+    for (int i = 0; i < N; i++) {
+        utlWriterSubmit(w, message(i));
+        if (__atomic_load_n(&live_allocs, __ATOMIC_RELAXED) != 0) held++;
+    }
+    utlSetThreadAllocator(prev);
+    __atomic_store_n(&sink.go, 1, __ATOMIC_RELEASE);
+    utlWriterFlush(w);
+    utl_writer_stats_t st;
+    utlWriterStats(w, &st);
+    utlWriterClose(w);
+    close(fds[1]);
+    pthread_join(th, NULL);
+    close(fds[0]);
+
+    int last = -1;
+    CHECK(held == 0, "%s: %d strings kept past Submit", name, held);
+    CHECK(st.dropped > 0 && st.written + st.dropped == (uint64_t)N && check_order(sink.data, &last) == (int)st.written,
+          "%s: written %llu dropped %llu", name, (unsigned long long)st.written, (unsigned long long)st.dropped);
+    free(sink.data);
+}
+
+int main(void) {
+    arena_submit();
+    custom_submit(UTL_WRITER_DROP_NEWEST, "custom drop-newest");
+    custom_submit(UTL_WRITER_SUMMARY, "custom summary");
+    custom_submit(UTL_WRITER_DROP_OLDEST, "custom drop-oldest");
+    run(UTL_WRITER_DROP_OLDEST, 0, "drop-oldest");
+    run(UTL_WRITER_DROP_OLDEST, 1, "drop-oldest");
+    run(UTL_WRITER_DROP_NEWEST, 1, "drop-newest");
+    run(UTL_WRITER_SUMMARY, 1, "summary");
+
+    CHECK(utlWriterOpen(1, 4, 0, UTL_WRITER_SUMMARY) == NULL, "four batches accepted");
+    CHECK(utlWriterSubmit(NULL, NULL) == -1, "NULL string accepted");
+
+    return test_report("writerutl");
+}